@@ -94,6 +94,24 @@ FString FArticyGVar::GetCPPTypeString() const
 	}
 }
 
+FString FArticyGVar::GetCPPFlatTypeString() const
+{
+	switch (Type)
+	{
+	case EArticyType::ADT_Boolean:
+		return TEXT("FArticyGvBool");
+
+	case EArticyType::ADT_Integer:
+		return TEXT("FArticyGvInt");
+
+	case EArticyType::ADT_String:
+		return TEXT("FArticyGvString");
+
+	default:
+		return TEXT("Cannot get CPP type string, unknown type!");
+	}
+}
+
 FString FArticyGVar::GetCPPValueString() const
 {
 	FString value;
@@ -954,6 +972,10 @@ void UArticyImportData::AddScriptFragment(const FString& Fragment, const bool bI
 	// regex pattern to find literal string, even if they contain escaped quotes (looks nasty if string escaped...): "([^"\\]|\\[\s\S])*" 
 	const FRegexPattern literalStringPattern(TEXT("\"([^\"\\\\]|\\\\[\\s\\S])*\""));
 
+	//match getProp/setProp up to the literal property path, the first argument is an object (self, speaker, ...)
+	//or a call without nested calls (getObj("Name") or getObj("Name", 1)): \b(?:getProp|setProp)\s*\(\s*(?:\w+\s*\((?:[^()"]|"(?:[^"\\]|\\[\s\S])*")*\)|\w+)\s*,\s*(?=")
+	const FRegexPattern propertyPathPattern(TEXT("\\b(?:getProp|setProp)\\s*\\(\\s*(?:\\w+\\s*\\((?:[^()\"]|\"(?:[^\"\\\\]|\\\\[\\s\\S])*\")*\\)|\\w+)\\s*,\\s*(?=\")"));
+
 	bool bCreateBlueprintableUserMethods = UArticyPluginSettings::Get()->bCreateBlueprintTypeForScriptMethods;
 
 	FString string = Fragment; //Fragment.Replace(TEXT("\n"), TEXT(""));
@@ -998,16 +1020,24 @@ void UArticyImportData::AddScriptFragment(const FString& Fragment, const bool bI
 			// we need to offset the values from the matcher based on the changes done to "line" in the loop
 			auto offset = 0;
 
-			// create FStrings from literal strings
+			// the literal property paths of getProp and setProp, by their start in the unmodified line
+			TSet<int32> propertyPathStarts;
+			FRegexMatcher propertyPaths(propertyPathPattern, line);
+			while (propertyPaths.FindNext())
+				propertyPathStarts.Add(propertyPaths.GetMatchEnding());
+
+			// create FStrings from literal strings, and property paths (split only once) from the paths of getProp and setProp
 			FRegexMatcher literalStrings(literalStringPattern, line);
 			while (literalStrings.FindNext())
 			{
+				const bool bIsPropertyPath = propertyPathStarts.Contains(literalStrings.GetMatchBeginning());
 				auto literalStart = literalStrings.GetMatchBeginning() + offset;
 				auto literalEnd = literalStrings.GetMatchEnding() + offset;
 
-				line = line.Left(literalStart) + TEXT("FString(TEXT(") + line.Mid(
+				const TCHAR* prefix = bIsPropertyPath ? TEXT("ARTICY_PROPERTY_PATH(TEXT(") : TEXT("FString(TEXT(");
+				line = line.Left(literalStart) + prefix + line.Mid(
 					literalStart, literalEnd - literalStart) + TEXT("))") + line.Mid(literalEnd);
-				offset += strlen("FString(TEXT(") + strlen("))");
+				offset += FCString::Strlen(prefix) + strlen("))");
 			}
 
 			//find all GV accesses (Namespace.Variable)
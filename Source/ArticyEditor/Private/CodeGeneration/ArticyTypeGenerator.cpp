@@ -43,12 +43,43 @@ void ArticyTypeGenerator::GenerateAsset(const UArticyImportData* Data)
 		// If we successfully created the asset, load the type information and notify the asset registry
 		if (UArticyTypeSystem* CreatedAsset = NewObject<UArticyTypeSystem>(AssetPackage, UClass, *FString(ClassName), Flags))
 		{
-			// Load type information
+			// Load type information, once per type instead of on every object
+			const auto& types = Data->GetObjectDefs().GetTypes();
+
+			// Features were merged into objects before the type of their template, so the
+			// last feature wins over the previous ones, but not over the type itself
+			auto MergeFeatures = [](FArticyType& articyType, const FArticyObjectDef& def)
+			{
+				const auto& features = def.GetFeatures();
+				for(int32 i = features.Num() - 1; i >= 0; --i)
+					articyType.MergeParent(features[i].GetArticyType());
+			};
+
 			CreatedAsset->Types.Reset();
-			for(const auto type : Data->GetObjectDefs().GetTypes())
+			for(const auto& type : types)
+			{
+				FArticyType articyType = type.Value.ArticyType;
+				MergeFeatures(articyType, type.Value);
+
+				// Inherit the data of the parent classes, like the objects used to do on import
+				for(const FArticyObjectDef* def = &type.Value; def->GetOriginalClass() != def->GetOriginalType();)
+				{
+					def = types.Find(def->GetOriginalClass());
+					if(!def)
+						break;
+					articyType.MergeParent(def->ArticyType);
+					MergeFeatures(articyType, *def);
+				}
+
+				CreatedAsset->Types.Add(type.Key.ToString(), articyType);
+			}
+
+			CreatedAsset->FeatureTypes.Reset();
+			for(const auto& feature : Data->GetObjectDefs().GetFeatures())
 			{
-				CreatedAsset->Types.Add(type.Key.ToString(), type.Value.ArticyType);
+				CreatedAsset->FeatureTypes.Add(feature.Key.ToString(), feature.Value.GetArticyType());
 			}
+			CreatedAsset->BuildIndices();
 		
 			// Notify the asset registry
 			FAssetRegistryModule::AssetCreated(Cast<UObject>(CreatedAsset));
@@ -129,6 +129,7 @@ bool CodeGenerator::DeleteExtraCode(const TArray<FString>& GeneratedFiles)
 			FString FileName = FPaths::GetCleanFilename(FilePath);
 
 			// Only applies to .h files - though there should not be anything else
+			// (the expresso scripts shards are deleted by the ExpressoScriptsGenerator, which knows which ones it generated)
 			if (FileName.EndsWith(TEXT(".h")))
 			{
 				// Check if the filename starts with any of the strings from the generated files
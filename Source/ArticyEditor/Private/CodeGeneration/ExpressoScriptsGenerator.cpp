@@ -118,57 +118,267 @@ void GenerateExpressoScripts(CodeFileGenerator* header, const UArticyImportData*
 	header->Line();
 	header->Line("public:", false, true, -1);
 
+	/**
+	 * Every fragment becomes a specialization of the Condition or Instruction member template,
+	 * keyed by its hash, which is called via a dispatch table sorted by hash.
+	 * Objects referencing a fragment store its index in the table on import (see GetFragmentIndices).
+	 */
+	header->Line();
+	header->Method("TArrayView<const FArticyExpressoDispatchEntry>", "GetConditionTable", "", nullptr, "", false, "", "const override");
+	header->Method("TArrayView<const FArticyExpressoDispatchEntry>", "GetInstructionTable", "", nullptr, "", false, "", "const override");
+
 	header->Line();
-	// disable "optimization cannot be applied due to function size" compile error. This error is caused by the huge constructor when all expresso
-	// scripts are added to the collection and this pragma disables the optimizations. 
-	header->Line("#if !((defined(PLATFORM_PS4) && PLATFORM_PS4) || (defined(PLATFORM_PS5) && PLATFORM_PS5))");
-	header->Line("#pragma warning(push)");
-	header->Line("#pragma warning(disable: 4883) //<disable \"optimization cannot be applied due to function size\" compile error.");
-	header->Line("#endif");
-	header->Method("", CodeGenerator::GetExpressoScriptsClassname(Data), "", [&]
-	{
-		const auto fragments = Data->GetScriptFragments();
-		for(auto script : fragments)
+	header->Line("private:", false, true, -1);
+	header->Line();
+	header->Line("template<uint32 Hash, int32 Variant>");
+	header->Line("bool Condition();");
+	header->Line("template<uint32 Hash, int32 Variant>");
+	header->Line("void Instruction();");
+
+	const int32 shardCount = UArticyPluginSettings::Get()->ExpressoScriptsShardCount;
+	if(shardCount > 0)
+	{
+		header->Line();
+		for(int32 i = 0; i < shardCount; ++i)
 		{
-			if(script.OriginalFragment.IsEmpty())
-				continue;
+			header->Line(FString::Printf(TEXT("static TArrayView<const FArticyExpressoDispatchEntry> GetConditionShard_%d();"), i));
+			header->Line(FString::Printf(TEXT("static TArrayView<const FArticyExpressoDispatchEntry> GetInstructionShard_%d();"), i));
+		}
+	}
+}
+
+/** Returns for each of the sorted fragments how many fragments with the same hash come before it. */
+TArray<int32> GetFragmentVariants(const TArray<const FArticyExpressoFragment*>& Fragments)
+{
+	TArray<int32> variants;
+	variants.SetNumZeroed(Fragments.Num());
+	for(int32 i = 1; i < Fragments.Num(); ++i)
+	{
+		if(GetTypeHash(Fragments[i]->OriginalFragment) == GetTypeHash(Fragments[i - 1]->OriginalFragment))
+			variants[i] = variants[i - 1] + 1;
+	}
+	return variants;
+}
+
+FString GetFragmentFunction(const FArticyExpressoFragment& Fragment, int32 Variant)
+{
+	return FString::Printf(TEXT("%s<%uu, %d>"), Fragment.bIsInstruction ? TEXT("Instruction") : TEXT("Condition"), GetTypeHash(Fragment.OriginalFragment), Variant);
+}
 
+/**
+ * Returns for each fragment an expression of the context it uses (see EArticyExpressoFragmentUsage),
+ * so the runtime can skip setting up the rest. Identifiers in string literals are ignored,
+ * anything else which might refer to the context counts as using it.
+ */
+TArray<FString> GetFragmentUsages(const UArticyImportData* Data, const TArray<const FArticyExpressoFragment*>& Fragments)
+{
+	TSet<FString> namespaces, userMethods;
+	for(const auto& ns : Data->GetGlobalVars().Namespaces)
+		namespaces.Add(ns.Namespace);
+	for(const auto& method : Data->GetUserMethods())
+		userMethods.Add(method.Name);
 
-			int cleanScriptHash = GetTypeHash(script.OriginalFragment);
+	TArray<FString> usages;
+	for(const auto fragment : Fragments)
+	{
+		const FString& text = fragment->ParsedFragment;
+		bool bUsesGV = false, bUsesObject = false, bUsesMethods = false;
 
-			if(script.bIsInstruction)
+		for(int32 i = 0; i < text.Len();)
+		{
+			//skip string literals
+			if(text[i] == '"')
 			{
-				header->Line(FString::Printf(TEXT("Instructions.Add(%d, [&]"), cleanScriptHash));
-				header->Line("{");
+				for(++i; i < text.Len() && text[i] != '"'; ++i)
 				{
-					header->Line(script.ParsedFragment, false, true, 1);
+					if(text[i] == '\\')
+						++i;
 				}
-				header->Line("});");
+				++i;
+				continue;
 			}
-			else
+
+			//skip numbers as a whole, so suffixes like 1.5f are not taken as identifiers
+			if(FChar::IsDigit(text[i]))
 			{
-				header->Line(FString::Printf(TEXT("Conditions.Add(%d, [&]"), cleanScriptHash));
-				header->Line("{");
-				{
-					//the fragment might be empty or contain only a comment, so we need to wrap it in
-					//the ConditionOrTrue method
-					header->Line("return ConditionOrTrue(", false, true, 1);
-					//now comes the fragment (in next line and indented)
-					header->Line(script.ParsedFragment, false, true, 2);
-					//make sure there is a final semicolon
-					//we put it into the next line, since the fragment might contain a line-comment
-					header->Line(");", false, true, 1);
-				}
-				header->Line("});");
+				for(; i < text.Len() && (FChar::IsAlnum(text[i]) || text[i] == '_'); ++i);
+				continue;
 			}
+
+			if(!FChar::IsAlpha(text[i]) && text[i] != '_')
+			{
+				++i;
+				continue;
+			}
+
+			const int32 start = i;
+			for(; i < text.Len() && (FChar::IsAlnum(text[i]) || text[i] == '_'); ++i);
+			const FString identifier = text.Mid(start, i - start);
+
+			if(namespaces.Contains(identifier) || identifier == TEXT("GetGV") || identifier == TEXT("ActiveGlobals"))
+				bUsesGV = true;
+			else if(identifier == TEXT("self") || identifier == TEXT("speaker"))
+				bUsesObject = true;
+			else if(userMethods.Contains(identifier) || identifier == TEXT("GetUserMethodsProviderObject") || identifier == TEXT("UserMethodsProvider"))
+				bUsesMethods = true;
 		}
-	});
-	header->Line("#if !((defined(PLATFORM_PS4) && PLATFORM_PS4) || (defined(PLATFORM_PS5) && PLATFORM_PS5))");
-	header->Line("#pragma warning(pop)");
-	header->Line("#endif");
+
+		TArray<FString> flags;
+		if(bUsesGV)
+			flags.Add(TEXT("EArticyExpressoFragmentUsage::GlobalVariables"));
+		if(bUsesObject)
+			flags.Add(TEXT("EArticyExpressoFragmentUsage::CurrentObject"));
+		if(bUsesMethods)
+			flags.Add(TEXT("EArticyExpressoFragmentUsage::UserMethods"));
+		usages.Add(flags.Num() > 0 ? FString::Join(flags, TEXT(" | ")) : TEXT("EArticyExpressoFragmentUsage::None"));
+	}
+	return usages;
+}
+
+/** Defines the member template specializations of the given fragments. */
+void GenerateFragments(CodeFileGenerator* file, const FString& ClassName, const TArray<const FArticyExpressoFragment*>& Fragments,
+	const TArray<int32>& Variants, const TArray<int32>& Indices, bool bInline)
+{
+	for(int32 i : Indices)
+	{
+		const auto& fragment = *Fragments[i];
+
+		file->Line();
+		file->Line("template<>");
+		file->Line(FString::Printf(TEXT("%s%s %s::%s()"), bInline ? TEXT("inline ") : TEXT(""),
+			fragment.bIsInstruction ? TEXT("void") : TEXT("bool"), *ClassName, *GetFragmentFunction(fragment, Variants[i])));
+		file->Line("{");
+		if(fragment.bIsInstruction)
+		{
+			file->Line(fragment.ParsedFragment, false, true, 1);
+		}
+		else
+		{
+			//the fragment might be empty or contain only a comment, so we need to wrap it in
+			//the ConditionOrTrue method
+			file->Line("return ConditionOrTrue(", false, true, 1);
+			//now comes the fragment (in next line and indented)
+			file->Line(fragment.ParsedFragment, false, true, 2);
+			//make sure there is a final semicolon
+			//we put it into the next line, since the fragment might contain a line-comment
+			file->Line(");", false, true, 1);
+		}
+		file->Line("}");
+	}
+}
+
+/** Adds the body of a method returning the dispatch table of the given fragments. */
+void GenerateDispatchTable(CodeFileGenerator* file, const FString& ClassName, const TArray<const FArticyExpressoFragment*>& Fragments,
+	const TArray<int32>& Variants, const TArray<FString>& Usages, const TArray<int32>& Indices)
+{
+	if(Indices.Num() == 0)
+	{
+		file->Line("return {};");
+		return;
+	}
+
+	file->Line("static const FArticyExpressoDispatchEntry Table[] =");
+	file->Line("{");
+	for(int32 i : Indices)
+	{
+		const auto& fragment = *Fragments[i];
+		const auto call = FString::Printf(TEXT("static_cast<%s*>(Scripts)->%s()"), *ClassName, *GetFragmentFunction(fragment, Variants[i]));
+		file->Line(FString::Printf(TEXT("{ %uu, [](UArticyExpressoScripts* Scripts) { %s; }, %s },"), GetTypeHash(fragment.OriginalFragment),
+			*(fragment.bIsInstruction ? call + TEXT("; return true") : TEXT("return ") + call), *Usages[i]), false, true, 1);
+	}
+	file->Line("};");
+	file->Line("return Table;");
 }
 
-void ExpressoScriptsGenerator::GenerateCode(const UArticyImportData* Data, FString& OutFile)
+/**
+ * Defines the fragments and the dispatch tables, either inline in the header,
+ * or spread across ExpressoScriptsShardCount source files.
+ */
+void GenerateFragmentDefinitions(CodeFileGenerator* header, const UArticyImportData* Data)
+{
+	const auto className = CodeGenerator::GetExpressoScriptsClassname(Data);
+	const int32 shardCount = UArticyPluginSettings::Get()->ExpressoScriptsShardCount;
+
+	const auto conditions = ExpressoScriptsGenerator::GetSortedFragments(Data, false);
+	const auto instructions = ExpressoScriptsGenerator::GetSortedFragments(Data, true);
+	const auto conditionVariants = GetFragmentVariants(conditions);
+	const auto instructionVariants = GetFragmentVariants(instructions);
+	const auto conditionUsages = GetFragmentUsages(Data, conditions);
+	const auto instructionUsages = GetFragmentUsages(Data, instructions);
+
+	if(shardCount <= 0)
+	{
+		TArray<int32> allConditions, allInstructions;
+		for(int32 i = 0; i < conditions.Num(); ++i)
+			allConditions.Add(i);
+		for(int32 i = 0; i < instructions.Num(); ++i)
+			allInstructions.Add(i);
+
+		GenerateFragments(header, className, conditions, conditionVariants, allConditions, true);
+		GenerateFragments(header, className, instructions, instructionVariants, allInstructions, true);
+
+		header->Line();
+		header->Method("inline TArrayView<const FArticyExpressoDispatchEntry>", className + "::GetConditionTable", "", [&]
+		{
+			GenerateDispatchTable(header, className, conditions, conditionVariants, conditionUsages, allConditions);
+		}, "", false, "", "const");
+		header->Line();
+		header->Method("inline TArrayView<const FArticyExpressoDispatchEntry>", className + "::GetInstructionTable", "", [&]
+		{
+			GenerateDispatchTable(header, className, instructions, instructionVariants, instructionUsages, allInstructions);
+		}, "", false, "", "const");
+		return;
+	}
+
+	//the header only merges the shards, so it does not change if just the fragments change
+	auto generateMerge = [&](const FString& TableName, const FString& ShardName)
+	{
+		header->Line();
+		header->Method("inline TArrayView<const FArticyExpressoDispatchEntry>", className + "::" + TableName, "", [&]
+		{
+			header->Line("static const TArray<FArticyExpressoDispatchEntry> Table = MergeDispatchTables({");
+			for(int32 i = 0; i < shardCount; ++i)
+				header->Line(FString::Printf(TEXT("%s_%d(),"), *ShardName, i), false, true, 1);
+			header->Line("});");
+			header->Line("return Table;");
+		}, "", false, "", "const");
+	};
+	generateMerge("GetConditionTable", "GetConditionShard");
+	generateMerge("GetInstructionTable", "GetInstructionShard");
+
+	//fragments are assigned to shards by hash, so changing a fragment only changes the content of its own shard
+	TArray<TArray<int32>> conditionShards, instructionShards;
+	conditionShards.SetNum(shardCount);
+	instructionShards.SetNum(shardCount);
+	for(int32 i = 0; i < conditions.Num(); ++i)
+		conditionShards[GetTypeHash(conditions[i]->OriginalFragment) % shardCount].Add(i);
+	for(int32 i = 0; i < instructions.Num(); ++i)
+		instructionShards[GetTypeHash(instructions[i]->OriginalFragment) % shardCount].Add(i);
+
+	for(int32 shard = 0; shard < shardCount; ++shard)
+	{
+		CodeFileGenerator(ExpressoScriptsGenerator::GetShardFilename(Data, shard), false, [&](CodeFileGenerator* cpp)
+		{
+			cpp->Line("#include \"" + ExpressoScriptsGenerator::GetFilename(Data) + "\"");
+
+			GenerateFragments(cpp, className, conditions, conditionVariants, conditionShards[shard], false);
+			GenerateFragments(cpp, className, instructions, instructionVariants, instructionShards[shard], false);
+
+			cpp->Line();
+			cpp->Method("TArrayView<const FArticyExpressoDispatchEntry>", FString::Printf(TEXT("%s::GetConditionShard_%d"), *className, shard), "", [&]
+			{
+				GenerateDispatchTable(cpp, className, conditions, conditionVariants, conditionUsages, conditionShards[shard]);
+			});
+			cpp->Line();
+			cpp->Method("TArrayView<const FArticyExpressoDispatchEntry>", FString::Printf(TEXT("%s::GetInstructionShard_%d"), *className, shard), "", [&]
+			{
+				GenerateDispatchTable(cpp, className, instructions, instructionVariants, instructionUsages, instructionShards[shard]);
+			});
+		});
+	}
+}
+
+void ExpressoScriptsGenerator::GenerateCode(UArticyImportData* Data, FString& OutFile)
 {
 	// Determine if we want to make the user methods blueprintable.
 	// (if true, we use a different naming to allow something like overloaded functions)
@@ -204,7 +414,11 @@ void ExpressoScriptsGenerator::GenerateCode(const UArticyImportData* Data, FStri
 			}
 
 		}, "BlueprintType, Blueprintable");
+
+		if(Data->GetSettings().set_UseScriptSupport)
+			GenerateFragmentDefinitions(header, Data);
 	});
+	DeleteUnusedShards(Data, Data->GetSettings().set_UseScriptSupport ? UArticyPluginSettings::Get()->ExpressoScriptsShardCount : 0);
 	OutFile = filename.Replace(TEXT(".h"), TEXT(""));
 }
 
@@ -212,3 +426,57 @@ FString ExpressoScriptsGenerator::GetFilename(const UArticyImportData* Data)
 {
 	return CodeGenerator::GetExpressoScriptsClassname(Data, true) + ".h";
 }
+
+FString ExpressoScriptsGenerator::GetShardFilename(const UArticyImportData* Data, int32 Shard)
+{
+	return FString::Printf(TEXT("%s_Shard%d.cpp"), *CodeGenerator::GetExpressoScriptsClassname(Data, true), Shard);
+}
+
+void ExpressoScriptsGenerator::DeleteUnusedShards(UArticyImportData* Data, int32 ShardCount)
+{
+	TArray<FString> shardFiles;
+	for(int32 shard = 0; shard < ShardCount; ++shard)
+		shardFiles.Add(GetShardFilename(Data, shard));
+
+	//only files this generator wrote itself are deleted, anything else in the folder is left alone
+	for(const auto& shardFile : Data->GetExpressoScriptsShardFiles())
+	{
+		if(!shardFiles.Contains(shardFile))
+			IFileManager::Get().Delete(*(CodeGenerator::GetSourceFolder() / shardFile));
+	}
+
+	Data->SetExpressoScriptsShardFiles(shardFiles);
+}
+
+TArray<const FArticyExpressoFragment*> ExpressoScriptsGenerator::GetSortedFragments(const UArticyImportData* Data, bool bInstructions)
+{
+	TArray<const FArticyExpressoFragment*> Fragments;
+	if(!Data->GetSettings().set_UseScriptSupport)
+		return Fragments;
+
+	for(const auto& script : Data->GetScriptFragments())
+	{
+		//empty fragments are handled by UArticyExpressoScripts itself
+		if(script.bIsInstruction == bInstructions && !script.OriginalFragment.IsEmpty())
+			Fragments.Add(&script);
+	}
+
+	//sort by hash for the binary search at runtime, and by text so the order is stable for equal hashes
+	Fragments.Sort([](const FArticyExpressoFragment& A, const FArticyExpressoFragment& B)
+	{
+		const uint32 HashA = GetTypeHash(A.OriginalFragment);
+		const uint32 HashB = GetTypeHash(B.OriginalFragment);
+		return HashA != HashB ? HashA < HashB : A.OriginalFragment < B.OriginalFragment;
+	});
+
+	return Fragments;
+}
+
+TMap<FString, int32> ExpressoScriptsGenerator::GetFragmentIndices(const UArticyImportData* Data, bool bInstructions)
+{
+	TMap<FString, int32> Indices;
+	const auto Fragments = GetSortedFragments(Data, bInstructions);
+	for(int32 i = 0; i < Fragments.Num(); ++i)
+		Indices.Add(Fragments[i]->OriginalFragment, i);
+	return Indices;
+}
@@ -12,7 +12,18 @@
 class ExpressoScriptsGenerator
 {
 public:
-	static void GenerateCode(const UArticyImportData* Data, FString& OutFile);
+	static void GenerateCode(UArticyImportData* Data, FString& OutFile);
 	/** Returns the filename of the generated expresso scripts class (with extension). */
 	static FString GetFilename(const UArticyImportData* Data);
+	/** Returns the filename of a source file holding a part of the script fragments (see UArticyPluginSettings::ExpressoScriptsShardCount). */
+	static FString GetShardFilename(const UArticyImportData* Data, int32 Shard);
+
+	/** Returns the non-empty conditions or instructions, in the order of the generated dispatch table. */
+	static TArray<const FArticyExpressoFragment*> GetSortedFragments(const UArticyImportData* Data, bool bInstructions);
+	/** Returns the index in the generated dispatch table for each condition or instruction, by original fragment text. */
+	static TMap<FString, int32> GetFragmentIndices(const UArticyImportData* Data, bool bInstructions);
+
+private:
+	/** Deletes the shard source files which were generated before, but not anymore, and records the current ones. */
+	static void DeleteUnusedShards(UArticyImportData* Data, int32 ShardCount);
 };
@@ -8,12 +8,15 @@
 #include "ArticyImportData.h"
 #include "ArticyGlobalVariables.h"
 #include "ArticyImporterHelpers.h"
+#include "ArticyPluginSettings.h"
 
 void GlobalVarsGenerator::GenerateCode(const UArticyImportData* Data, FString& OutFile)
 {
 	if(!ensure(Data))
 		return;
 
+	const bool bFlatStorage = UArticyPluginSettings::Get()->bUseFlatGlobalVariableStorage;
+
 	OutFile = CodeGenerator::GetGlobalVarsClassname(Data, true);
 	CodeFileGenerator(OutFile + ".h", true, [&](CodeFileGenerator* header)
 	{
@@ -37,19 +40,28 @@ void GlobalVarsGenerator::GenerateCode(const UArticyImportData* Data, FString& O
 				//generate all the variables in public section
 				header->Line("public:", false, true, -1);
 
-				for(const FArticyGVar var : ns.Variables)
-					header->Variable(var.GetCPPTypeString() + "*", var.Variable, "nullptr", var.Description, true,
-									FString::Printf(TEXT("VisibleAnywhere, BlueprintReadOnly, Category=\"%s\""), *ns.Namespace));
+				if(bFlatStorage)
+				{
+					//the values live in the store, the variables only refer to them
+					for(const FArticyGVar var : ns.Variables)
+						header->Variable(var.GetCPPFlatTypeString(), var.Variable, "", var.Description);
+				}
+				else
+				{
+					for(const FArticyGVar var : ns.Variables)
+						header->Variable(var.GetCPPTypeString() + "*", var.Variable, "nullptr", var.Description, true,
+										FString::Printf(TEXT("VisibleAnywhere, BlueprintReadOnly, Category=\"%s\""), *ns.Namespace));
 
-				header->Line();
+					header->Line();
 
-				//in the constructor, create the subobject for all the variables
-				header->Method("", ns.CppTypename, "", [&]
-				{
-					//create subobject
-					for(const auto var : ns.Variables)
-						header->Line(FString::Printf(TEXT("%s = CreateDefaultSubobject<%s>(\"%s\");"), *var.Variable, *var.GetCPPTypeString(), *var.Variable));
-				});
+					//in the constructor, create the subobject for all the variables
+					header->Method("", ns.CppTypename, "", [&]
+					{
+						//create subobject
+						for(const auto var : ns.Variables)
+							header->Line(FString::Printf(TEXT("%s = CreateDefaultSubobject<%s>(\"%s\");"), *var.Variable, *var.GetCPPTypeString(), *var.Variable));
+					});
+				}
 
 				header->Line();
 
@@ -60,6 +72,12 @@ void GlobalVarsGenerator::GenerateCode(const UArticyImportData* Data, FString& O
 
 					for(const auto var : ns.Variables)
 					{
+						if(bFlatStorage)
+						{
+							header->Line(FString::Printf(TEXT("%s.Init(this, Store, TEXT(\"%s.%s\"), %s);"), *var.Variable, *ns.Namespace, *var.Variable, *var.GetCPPValueString()));
+							continue;
+						}
+
 						header->Line(FString::Printf(TEXT("%s->Init<%s>(this, Store, TEXT(\"%s.%s\"), %s);"), *var.Variable, *var.GetCPPTypeString(), *ns.Namespace, *var.Variable, *var.GetCPPValueString()));
 						header->Line(FString::Printf(TEXT("this->Variables.Add(%s);"), *var.Variable));
 					}					
@@ -69,6 +87,21 @@ void GlobalVarsGenerator::GenerateCode(const UArticyImportData* Data, FString& O
 
 		header->Line();
 
+		//generate the ids of the variables, in the order in which the namespaces initialize them
+		const auto idType = TEXT("E") + OutFile + TEXT("Id");
+		header->Comment(TEXT("The ids of all global variables, which can be used to create an FArticyGvHandle."));
+		header->Line(TEXT("enum class ") + idType + TEXT(" : int32"));
+		header->Block(true, [&]
+		{
+			for(const auto ns : Data->GetGlobalVars().Namespaces)
+			{
+				for(const auto var : ns.Variables)
+					header->Line(FString::Printf(TEXT("%s_%s,"), *ns.Namespace, *var.Variable));
+			}
+		}, true);
+
+		header->Line();
+
 		//now generate the UArticyGlobalVariables class
 		const auto type = CodeGenerator::GetGlobalVarsClassname(Data, false);
 		header->Class(type + " : public UArticyGlobalVariables", TEXT("Global Articy Variables"), true, [&]
@@ -108,6 +141,24 @@ void GlobalVarsGenerator::GenerateCode(const UArticyImportData* Data, FString& O
 				}
 			});
 
+			//---------------------------------------------------------------------------//
+			if(bFlatStorage)
+			{
+				header->Line();
+				header->Method(TEXT("bool"), TEXT("UsesFlatStorage"), TEXT(""), [&]
+				{
+					header->Line(TEXT("return true;"));
+				}, TEXT(""), false, TEXT(""), TEXT("const override"));
+			}
+
+			//---------------------------------------------------------------------------//
+			header->Line();
+
+			header->Method(TEXT("static FArticyGvHandle"), TEXT("GetHandle"), idType + TEXT(" Id"), [&]
+			{
+				header->Line(TEXT("return FArticyGvHandle(static_cast<int32>(Id));"));
+			}, TEXT("Get a handle to the variable with the given id."));
+
 			//---------------------------------------------------------------------------//
 			header->Line();
 
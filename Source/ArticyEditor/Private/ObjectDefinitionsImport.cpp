@@ -68,8 +68,6 @@ void FArticyTemplateDef::InitializeModel(UArticyPrimitive* Model, const FString&
 		if(Values->TryGetObjectField(feat.GetTechnicalName(), featureJson))
 			feat.InitializeModel(Model, Path, *featureJson, Data, PackageName);
 	}
-
-	Model->ArticyType.MergeChild(ArticyType);
 }
 
 //---------------------------------------------------------------------------//
@@ -233,8 +231,11 @@ void FArticyObjectDef::InitializeModel(
 		//try setting the "meta" data (not stored in the properties array)
 		const auto AssetRef = FName{ TEXT("AssetRef") };
 		const auto Category = FName{ TEXT("Category") };
+		const auto AssetPath = FName{ TEXT("AssetPath") };
 		Model->SetProp(AssetRef, Vals.GetAssetRef());
 		Model->SetProp(Category, Vals.GetAssetCat());
+		//resolved once here, so loading the asset at runtime needs no path operations
+		Model->SetProp(AssetPath, UArticyAsset::MakeAssetPath(Vals.GetAssetRef()));
 	}
 
 	const auto nameAndId = Vals.GetNameAndId();
@@ -251,8 +252,6 @@ void FArticyObjectDef::InitializeModel(
 		Template.InitializeModel(Model, nameAndId, featuresJson, Data, PackageName);
 	else
 		ensure(Template.GetDisplayName().IsEmpty());
-
-	Model->ArticyType.MergeChild(ArticyType);
 }
 
 FString FArticyObjectDef::GetCppType(const UArticyImportData* Data, const bool bForProperty) const
@@ -447,8 +446,6 @@ void FArticyPropertyDef::InitializeModel(
 		return;
 
 	FArticyObjectDefinitions::SetProp(ItemType.IsNone() ? Type : ItemType, GetPropetyName(), Model, Path + "." + Property.ToString(), jsonValue, PackageName);
-
-	Model->ArticyType.MergeParent(ArticyType);
 }
 
 FString FArticyPropertyDef::GetCppType(const UArticyImportData* Data) const
@@ -575,8 +572,6 @@ void FArticyTemplateFeatureDef::InitializeModel(
 	const auto path = Path + "." + *TechnicalName;
 	for(const auto& prop : Properties)
 		prop.InitializeModel(feature, path, Json, Data, PackageName);
-
-	Model->ArticyType.MergeChild(ArticyType);
 }
 
 UClass* FArticyTemplateFeatureDef::GetUClass(const UArticyImportData* Data) const
@@ -7,7 +7,11 @@
 #include "ArticyImporterHelpers.h"
 #include "ArticyImportData.h"
 #include "CodeGeneration/CodeGenerator.h"
+#include "CodeGeneration/ExpressoScriptsGenerator.h"
 #include "ArticyObject.h"
+#include "ArticyPins.h"
+#include "ArticyScriptFragment.h"
+#include "UObject/UObjectHash.h"
 #include "Policies/CondensedJsonPrintPolicy.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
@@ -547,10 +551,31 @@ void FArticyPackageDefs::GenerateAssets(UArticyImportData* Data) const
 	//store gathered information about who has which children in generated assets
 	auto parentChildrenCache = Data->GetParentChildrenCache();
 	const auto childrenProp = FName{ TEXT("Children") };
+
+	//the index of each script in the dispatch tables of the generated expresso scripts
+	const auto conditionIndices = ExpressoScriptsGenerator::GetFragmentIndices(Data, false);
+	const auto instructionIndices = ExpressoScriptsGenerator::GetFragmentIndices(Data, true);
+	auto getScriptIndex = [&](const FString& Script, bool bIsInstruction)
+	{
+		const int32* index = (bIsInstruction ? instructionIndices : conditionIndices).Find(Script);
+		return index ? *index : INDEX_NONE;
+	};
+
 	for (auto pack : ArticyPackages)
 	{
 		for (auto obj : pack->GetAssets())
 		{
+			//pins and script fragments are subobjects of the asset
+			TArray<UObject*> subobjects;
+			GetObjectsWithOuter(obj, subobjects, true);
+			for (auto subobject : subobjects)
+			{
+				if (auto pin = Cast<UArticyFlowPin>(subobject))
+					pin->ScriptIndex = getScriptIndex(pin->Text, pin->IsA<UArticyOutputPin>());
+				else if (auto fragment = Cast<UArticyScriptFragment>(subobject))
+					fragment->SetFragmentIndex(getScriptIndex(fragment->GetExpression(), fragment->IsA<UArticyScriptInstruction>()));
+			}
+
 			if (auto articyObj = Cast<UArticyObject>(obj))
 			{
 				if (auto children = parentChildrenCache.Find(articyObj->GetId()))
@@ -564,6 +589,9 @@ void FArticyPackageDefs::GenerateAssets(UArticyImportData* Data) const
 				}
 			}
 		}
+
+		//precompile the flow for exploration now that all pins and connections are known
+		pack->BuildFlowGraph();
 	}
 }
 
@@ -77,10 +77,10 @@ void SArticyVariableSet::BuildVariableWidgets()
 		return;
 	}
 
-	TArray<UArticyVariable*> SortedVars = VariableSet->Variables;
+	TArray<UArticyVariable*> SortedVars = VariableSet->GetVariables();
 	SortedVars.Sort([](const UArticyVariable& LHS, const UArticyVariable& RHS)
 	{
-		return LHS.GetName().Compare(RHS.GetName(), ESearchCase::IgnoreCase) < 0 ? true : false;
+		return LHS.GetGVName().ToString().Compare(RHS.GetGVName().ToString(), ESearchCase::IgnoreCase) < 0 ? true : false;
 	});
 	
 	for (UArticyVariable* Var : SortedVars)
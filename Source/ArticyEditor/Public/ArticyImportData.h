@@ -132,6 +132,8 @@ public:
 
 	/** Returns the UArticyVariable type to be used for this variable. */
 	FString GetCPPTypeString() const;
+	/** Returns the type to be used for this variable if the global variables use flat storage. */
+	FString GetCPPFlatTypeString() const;
 	FString GetCPPValueString() const;
 
 	void ImportFromJson(const TSharedPtr<FJsonObject> JsonVar);
@@ -416,6 +418,9 @@ public:
 	bool HasCachedVersion() const { return bHasCachedVersion; }
 
 	void SetInitialImportComplete() { bHasCachedVersion = true; }
+
+	const TArray<FString>& GetExpressoScriptsShardFiles() const { return ExpressoScriptsShardFiles; }
+	void SetExpressoScriptsShardFiles(const TArray<FString>& ShardFiles) { ExpressoScriptsShardFiles = ShardFiles; }
 	
 	UPROPERTY(VisibleAnywhere, Category = "ImportData")
 	FArticyLanguages Languages;
@@ -457,6 +462,10 @@ private:
 	UPROPERTY(VisibleAnywhere, Category="Imported")
 	TMap<FArticyId, FArticyIdArray> ParentChildrenCache;
 
+	/** The expresso scripts shard source files generated by the last import (see UArticyPluginSettings::ExpressoScriptsShardCount). */
+	UPROPERTY(VisibleAnywhere, Category="Imported")
+	TArray<FString> ExpressoScriptsShardFiles;
+
 	void ImportAudioAssets(const FString& BaseContentDir, const FString& SubDir);
 	int ProcessStrings(StringTableGenerator* CsvOutput, const TMap<FString, FArticyTexts>& Data, const TPair<FString, FArticyLanguageDef>& Language);
 };
@@ -117,6 +117,7 @@ public:
 
 	FString GetTechnicalName() const { return TechnicalName; }
 	FString GetDisplayName() const { return DisplayName; }
+	const FArticyType& GetArticyType() const { return ArticyType; }
 
 private:
 	UPROPERTY(VisibleAnywhere, Category="TemplateFeature")
@@ -205,6 +206,8 @@ public:
 	FString GetCppType(const UArticyImportData* Data, const bool bForProperty) const;
 	FString GetCppBaseClasses(const UArticyImportData* Data) const;
 	const FName& GetOriginalType() const { return Type; }
+	/** The original type this type inherits its data from, equal to GetOriginalType if there is none. */
+	const FName& GetOriginalClass() const { return Class; }
 	const TArray<FArticyTemplateFeatureDef>& GetFeatures() const;
 
 	UPROPERTY(VisibleAnywhere, Category="ObjectDef")
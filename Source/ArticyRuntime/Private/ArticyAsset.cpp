@@ -3,38 +3,14 @@
 //
 
 #include "ArticyAsset.h"
-#include "UObject/ConstructorHelpers.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
 #include "Misc/Paths.h"
 
 UObject* UArticyAsset::LoadAsset() const
 {
-	//if(!Asset.IsValid())
-	{
-		/*static TArray<FAssetData> assets;
-
-		if(assets.Num() == 0)
-		{
-			static TWeakObjectPtr<UObjectLibrary> lib = nullptr;
-			if(!lib.IsValid())
-				lib = UObjectLibrary::CreateLibrary(UObject::StaticClass(), false, GIsEditor);
-
-			lib->LoadAssetDataFromPath(ArticyHelpers::ArticyAssetsFolder);
-			lib->GetAssetDataList(assets);
-		}*/
-
-		const auto folder = FPaths::GetPath(AssetRef);
-		const auto filename = FPaths::GetBaseFilename(AssetRef); //without extension
-
-		//construct the asset path like UE4 wants it
-		auto path = ArticyHelpers::GetArticyResourcesFolder() / folder / filename;
-		//UE_LOG(LogTemp, Warning, TEXT("Asset Path %s"), *path)
-#if ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION <= 24
-		Asset = ConstructorHelpersInternal::FindOrLoadObject<UObject>(path);
-#else
-		Asset = ConstructorHelpersInternal::FindOrLoadObject<UObject>(path, LOAD_None);
-#endif
-		
-	}
+	if(!Asset.IsValid())
+		Asset = GetAssetPath().TryLoad();
 
 	return Asset.Get();
 }
@@ -59,4 +35,90 @@ UFileMediaSource* UArticyAsset::LoadAsFileMediaSource() const
 	return Cast<UFileMediaSource>(LoadAsset());
 }
 
+void UArticyAsset::LoadAssetAsync(const FOnArticyAssetLoaded& OnLoaded) const
+{
+	LoadAssetAsync([OnLoaded](UObject* LoadedAsset)
+	{
+		OnLoaded.ExecuteIfBound(LoadedAsset);
+	});
+}
+
+void UArticyAsset::LoadAssetAsync(FArticyAssetLoadedCallback OnLoaded) const
+{
+	const FSoftObjectPath Path = GetAssetPath();
+	if(Asset.IsValid() || Path.IsNull())
+	{
+		if(OnLoaded)
+			OnLoaded(Asset.Get());
+		return;
+	}
+
+	//the handle keeps the loaded asset alive until the callback ran, Asset only caches it weakly
+	TSharedRef<TSharedPtr<FStreamableHandle>> HandleHolder = MakeShared<TSharedPtr<FStreamableHandle>>();
+	TWeakObjectPtr<const UArticyAsset> WeakThis = this;
+	TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Path, [WeakThis, Path, OnLoaded, HandleHolder]()
+	{
+		UObject* LoadedAsset = Path.ResolveObject();
+		if(WeakThis.IsValid())
+			WeakThis->Asset = LoadedAsset;
+
+		if(OnLoaded)
+			OnLoaded(LoadedAsset);
+
+		//the handle holds this callback, so the holder must not keep the handle any longer
+		HandleHolder->Reset();
+	});
+
+	//a completed handle is kept by the streamable manager until its (possibly deferred) callback ran
+	if(Handle.IsValid() && !Handle->HasLoadCompleted())
+	{
+		*HandleHolder = Handle;
+		Handle->BindCancelDelegate(FStreamableDelegate::CreateLambda([HandleHolder]() { HandleHolder->Reset(); }));
+	}
+}
+
+TSharedPtr<FStreamableHandle> UArticyAsset::PrefetchAssets(const TArray<const UArticyAsset*>& Assets)
+{
+	TArray<FSoftObjectPath> Paths;
+	for(const auto ArticyAsset : Assets)
+	{
+		if(!ArticyAsset || ArticyAsset->Asset.IsValid())
+			continue;
+
+		const FSoftObjectPath Path = ArticyAsset->GetAssetPath();
+		if(!Path.IsNull())
+			Paths.AddUnique(Path);
+	}
+
+	if(Paths.Num() == 0)
+		return nullptr;
+
+	return UAssetManager::GetStreamableManager().RequestAsyncLoad(Paths);
+}
+
+FSoftObjectPath UArticyAsset::GetAssetPath() const
+{
+	//assets imported before the path was stored only have the AssetRef
+	return AssetPath.IsNull() ? MakeAssetPath(AssetRef) : AssetPath;
+}
+
+FSoftObjectPath UArticyAsset::MakeAssetPath(const FString& AssetRef)
+{
+	if(AssetRef.IsEmpty())
+		return {};
 
+	const auto folder = FPaths::GetPath(AssetRef);
+	const auto filename = FPaths::GetBaseFilename(AssetRef); //without extension
+
+	//construct the asset path like UE4 wants it
+	const auto path = ArticyHelpers::GetArticyResourcesFolder() / folder / filename;
+	return FSoftObjectPath{ path + TEXT(".") + filename };
+}
+
+void UArticyAsset::PostLoad()
+{
+	Super::PostLoad();
+
+	if(AssetPath.IsNull())
+		AssetPath = MakeAssetPath(AssetRef);
+}
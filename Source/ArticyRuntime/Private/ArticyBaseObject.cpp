@@ -20,10 +20,52 @@ void UArticyBaseObject::AddSubobject(UArticyPrimitive* Obj)
 
 FArticyType UArticyBaseObject::GetArticyType() const
 {
-	return ArticyType;
+	return GetArticyTypeRef();
+}
+
+const FArticyType& UArticyBaseObject::GetArticyTypeRef() const
+{
+	static const FArticyType Empty;
+	const UArticyTypeSystem* TypeSystem = UArticyTypeSystem::Get();
+	return TypeSystem ? TypeSystem->GetArticyTypeOfClass(GetObjectClass()) : Empty;
 }
 
 FText UArticyBaseObject::GetPropertyText(const FText Property)
 {
 	return ArticyHelpers::LocalizeString(this, Property, true, &Property);
 }
+
+//---------------------------------------------------------------------------//
+
+IArticyReflectable* UArticyBaseFeature::PrepareForWrite()
+{
+	auto Owner = Cast<UArticyBaseObject>(GetOuter());
+	if(!Owner)
+		return this;
+
+	auto WritableOwner = Owner->PrepareForWrite();
+	if(!WritableOwner)
+		return nullptr;
+
+	return FindInOwner(WritableOwner->_getUObject());
+}
+
+const IArticyReflectable* UArticyBaseFeature::GetReadTarget() const
+{
+	//only features of shared package assets are read from the owner's copy
+	auto Owner = Cast<UArticyPrimitive>(GetOuter());
+	if(!Owner || !Owner->IsSharedAsset())
+		return this;
+
+	return FindInOwner(Owner->GetReadTarget()->_getUObject());
+}
+
+UArticyBaseFeature* UArticyBaseFeature::FindInOwner(UObject* Owner) const
+{
+	if(!Owner || Owner == GetOuter())
+		return const_cast<UArticyBaseFeature*>(this);
+
+	//the private copy contains a duplicate of this feature with the same name
+	auto Feature = FindObject<UArticyBaseFeature>(Owner, *GetName());
+	return Feature ? Feature : const_cast<UArticyBaseFeature*>(this);
+}
@@ -8,7 +8,9 @@
 #include "ArticyGlobalVariables.h"
 #include "ArticyPluginSettings.h"
 #include "ArticyExpressoScripts.h"
+#include "ArticyTypeSystem.h"
 #include "Misc/Paths.h"
+#include "Misc/ScopeRWLock.h"
 
 UArticyObject* FArticyObjectShadow::GetObject()
 {
@@ -21,50 +23,64 @@ FArticyShadowableObject::FArticyShadowableObject(UArticyObject* Object, int32 Cl
 	ShadowCopies.Add(FArticyObjectShadow(0, Object, CloneId, Outer));
 }
 
-UArticyObject* FArticyShadowableObject::Get(const IShadowStateManager* ShadowManager, bool bForceUnshadowed) const
+void FArticyShadowableObject::SetUnshadowed(UArticyObject* Object)
 {
-	if (bForceUnshadowed)
+	if(ensure(ShadowCopies.Num() > 0))
+		ShadowCopies[0] = FArticyObjectShadow(0, Object, ShadowCopies[0].GetCloneId());
+}
+
+UArticyObject* FArticyShadowableObject::Get(const IShadowStateManager* ShadowManager, const UArticyCloneableObject* Owner, bool bForceUnshadowed) const
+{
+	//with a property undo log, writes are rolled back instead of going to shadow copies
+	if (bForceUnshadowed || ShadowManager->UsesPropertyUndoLog())
 		return ShadowCopies[0].GetObject();
 
 	const auto ShadowLvl = ShadowManager->GetShadowLevel();
-	FArticyObjectShadow* info = ShadowCopies.FindByPredicate([&](const FArticyObjectShadow& item)
-	{
-		return item.ShadowLevel == ShadowLvl;
-	});
+	if(!ensureMsgf(ShadowCopies.Num() > 0, TEXT("Cannot get shadow level %d of FArticyShadowableObject!"), ShadowLvl))
+		return nullptr;
 
-	if(info)
-		return info->GetObject();
+	//shadow levels are strictly stacked, and copies of popped levels are removed right away,
+	//so the most recent shadow is either the requested one or below it
+	auto& mostRecentShadow = ShadowCopies.Last();
+	if(mostRecentShadow.ShadowLevel == ShadowLvl)
+		return mostRecentShadow.GetObject();
 
-	if(!ensureMsgf(ShadowLvl > 0 && ShadowCopies.Num() > 0, TEXT("Cannot get shadow level %d of FArticyShadowableObject!"), ShadowLvl))
+	if(!ensureMsgf(mostRecentShadow.ShadowLevel < ShadowLvl, TEXT("Shadow level %d of FArticyShadowableObject was not popped!"), mostRecentShadow.ShadowLevel))
 		return nullptr;
 
 	//create a new shadow copy
-	auto& mostRecentShadow = ShadowCopies.Last();
 	auto SourceObject = mostRecentShadow.GetObject();
-	auto obj = DuplicateObject(SourceObject, SourceObject);
+	//shared package assets must not become the outer of temporary copies
+	auto obj = DuplicateObject(SourceObject, SourceObject->IsSharedAsset() ? GetTransientPackage() : SourceObject);
 	ShadowCopies.Add(FArticyObjectShadow(ShadowLvl, obj, mostRecentShadow.GetCloneId()) );
-	
-#if __cplusplus >= 202002L
-	const_cast<IShadowStateManager*>(ShadowManager)->RegisterOnPopState([=, this]
-#else
-	const_cast<IShadowStateManager*>(ShadowManager)->RegisterOnPopState([=]
-#endif
-	{
-		//when the state is popped, remove the shadow copy again
-		//it is destroyed automatically, unless there is an owning reference to it
-		ensure(ShadowCopies.Last().ShadowLevel == ShadowLvl);
-		ShadowCopies.RemoveAt(ShadowCopies.Num() - 1);
-	});
+
+	//when the state is popped, remove the shadow copy again
+	//(logged by container and clone id, this might be moved when the container adds clones in the meantime)
+	const_cast<IShadowStateManager*>(ShadowManager)->AddToUndoLog(const_cast<UArticyCloneableObject*>(Owner), mostRecentShadow.GetCloneId(), &UArticyCloneableObject::PopShadowCopy);
 
 	//return the new shadow copy
 	return obj;
 }
 
+void FArticyShadowableObject::PopShadowCopy()
+{
+	//the copy is destroyed automatically, unless there is an owning reference to it
+	if(ensure(ShadowCopies.Num() > 1))
+		ShadowCopies.Pop(false);
+}
+
+void UArticyCloneableObject::PopShadowCopy(UObject* Owner, int32 CloneId)
+{
+	auto info = CastChecked<UArticyCloneableObject>(Owner)->Clones.Find(CloneId);
+	if(ensure(info))
+		info->PopShadowCopy();
+}
+
 UArticyObject* UArticyCloneableObject::Get(const IShadowStateManager* ShadowManager, int32 CloneId,
                                            bool bForceUnshadowed) const
 {
 	auto info = Clones.Find(CloneId);
-	return info ? info->Get(ShadowManager, bForceUnshadowed) : nullptr;
+	return info ? info->Get(ShadowManager, this, bForceUnshadowed) : nullptr;
 }
 
 UArticyObject* UArticyCloneableObject::Clone(const IShadowStateManager* ShadowManager, int32 CloneId,
@@ -81,8 +97,8 @@ UArticyObject* UArticyCloneableObject::Clone(const IShadowStateManager* ShadowMa
 		auto original = Get(ShadowManager);
 		if(ensure(original))
 		{
-			//create the clone
-			clone = DuplicateObject(original, original);
+			//create the clone (a shared asset is never used as outer, so it stays untouched)
+			clone = DuplicateObject(original, IsShared() ? GetOuter() : original);
 			AddClone(clone, CloneId);
 		}
 	}
@@ -90,6 +106,54 @@ UArticyObject* UArticyCloneableObject::Clone(const IShadowStateManager* ShadowMa
 	return clone;
 }
 
+void UArticyCloneableObject::InitShared(UArticyObject* Asset)
+{
+	if(!ensure(Asset))
+		return;
+
+	if(Asset->CopyOnWriteOwner.IsValid() && Asset->CopyOnWriteOwner.Get() != this)
+	{
+		//the asset is already shared by another database instance, so this one needs its own copy
+		Init(DuplicateObject<UArticyObject>(Asset, GetOuter()));
+		return;
+	}
+
+	SharedAsset = Asset;
+	Asset->CopyOnWriteOwner = this;
+	Asset->bSharedAsset = true;
+	AddClone(Asset, 0);
+}
+
+bool UArticyCloneableObject::IsShared() const
+{
+	return SharedAsset && Get(nullptr, 0, /*bForceUnshadowed = */ true) == SharedAsset;
+}
+
+UArticyObject* UArticyCloneableObject::Materialize()
+{
+	auto info = Clones.Find(0);
+	if(!info)
+		return nullptr;
+
+	UArticyObject* Current = info->Get(nullptr, this, true);
+	if(!SharedAsset || Current != SharedAsset)
+		return Current;
+
+	//the asset keeps pointing to this container, so writes through it keep going to the copy
+	auto Copy = DuplicateObject<UArticyObject>(SharedAsset, GetOuter());
+	info->SetUnshadowed(Copy);
+
+	return Copy;
+}
+
+void UArticyCloneableObject::ReleaseShared()
+{
+	if(SharedAsset && SharedAsset->CopyOnWriteOwner.Get() == this)
+		SharedAsset->CopyOnWriteOwner.Reset();
+
+	SharedAsset = nullptr;
+}
+
 void UArticyCloneableObject::AddClone(UArticyObject* Clone, int32 CloneId)
 {
 	if(!ensure(Clone))
@@ -144,24 +208,34 @@ UArticyDatabase* UArticyDatabase::Get(const UObject* WorldContext)
 		//clone not valid, create a new one
 		UE_LOG(LogArticyRuntime, Log, TEXT("Cloning ArticyDatabase."))
 
+		//load the type system here on the game thread, type lookups from other threads only read it
+		UArticyTypeSystem::Get();
+
 		//get the original asset to clone from
 		auto asset = GetOriginal();
 		if(!asset)
 			return nullptr;
 
-		//duplicate the original asset
-		if(bKeepBetweenWorlds)
+		UObject* Outer = bKeepBetweenWorlds ? Cast<UObject>(world->GetGameInstance()) : Cast<UObject>(world);
+
+		if(UArticyPluginSettings::Get()->bUseCopyOnWriteObjects)
 		{
-			clone = DuplicateObject((UArticyDatabase*)asset, world->GetGameInstance());
-#if !WITH_EDITOR
-			clone->AddToRoot();
-#endif
+			//only the package list is needed, anything the original has loaded stays with the original
+			clone = NewObject<UArticyDatabase>(Outer, asset->GetClass());
+			clone->ImportedPackages = asset->ImportedPackages;
+			clone->ExpressoScriptsClass = asset->ExpressoScriptsClass;
 		}
 		else
 		{
-			clone = DuplicateObject((UArticyDatabase*)asset, world);
+			//duplicate the original asset
+			clone = DuplicateObject((UArticyDatabase*)asset, Outer);
 		}
 
+#if !WITH_EDITOR
+		if(bKeepBetweenWorlds)
+			clone->AddToRoot();
+#endif
+
 		//make the clone load its default packages
 		if(clone.IsValid())
 			clone->Init();
@@ -286,6 +360,9 @@ void UArticyDatabase::LoadPackage(FString PackageName)
 	
 	UArticyPackage* Package = ImportedPackages[PackageName];
 
+	//the database asset itself always works on copies, only runtime instances share the package assets
+	const bool bCopyOnWrite = UArticyPluginSettings::Get()->bUseCopyOnWriteObjects && !IsAsset();
+
 	/*auto fileName = PackageName.Replace(TEXT(" "), TEXT("_"));
 	auto pkgFile = Cast<UPackage>(::LoadPackage(nullptr, *fileName, 0));
 	if(!pkgFile)
@@ -297,31 +374,267 @@ void UArticyDatabase::LoadPackage(FString PackageName)
 	//load the package, to make sure all the contained objects are available
 	pkgFile->FullyLoad();*/
 
+	TArray<UArticyCloneableObject*> Containers;
+	Containers.Reserve(Package->GetAssets().Num());
 	for (auto ArticyObject : Package->GetAssets())// MM_CHANGE
 	{
-		auto id = FArticyId(ArticyObject->GetId());
+		if (auto CloneContainer = CreateCloneContainer(ArticyObject, bCopyOnWrite))
+			Containers.Add(CloneContainer);
+	}
 
-		if (!ensureMsgf(!LoadedObjectsById.Contains(id), TEXT("Object with id [%d,%d] already in list!"), id.High, id.Low))
+	CommitLoadedPackage(PackageName, Containers);
+}
+
+void UArticyDatabase::LoadPackageAsync(FString PackageName, const FOnArticyPackageLoaded& OnLoaded)
+{
+	LoadPackageAsync(PackageName, [OnLoaded](const FString& LoadedPackageName, bool bSucceeded)
+	{
+		OnLoaded.ExecuteIfBound(LoadedPackageName, bSucceeded);
+	});
+}
+
+void UArticyDatabase::LoadPackageAsync(const FString& PackageName, FArticyPackageLoadedCallback OnLoaded)
+{
+	if (LoadedPackages.Contains(PackageName))
+	{
+		UE_LOG(LogArticyRuntime, Log, TEXT("Package %s already loaded."), *PackageName);
+		if (OnLoaded)
+			OnLoaded(PackageName, true);
+		return;
+	}
+
+	if (!ImportedPackages.Contains(PackageName) || ImportedPackages[PackageName] == nullptr)
+	{
+		UE_LOG(LogArticyRuntime, Error, TEXT("Failed to find Package %s in imported packages!"), *PackageName);
+		if (OnLoaded)
+			OnLoaded(PackageName, false);
+		return;
+	}
+
+	//the package is already on its way, just wait for it as well
+	if (auto Pending = PendingPackageLoads.Find(PackageName))
+	{
+		if (OnLoaded)
+			Pending->Callbacks.Add(OnLoaded);
+		return;
+	}
+
+	UArticyPackage* Package = ImportedPackages[PackageName];
+
+	auto& Pending = PendingPackageLoads.Add(PackageName);
+	Pending.Package = Package;
+	Pending.Containers.Reserve(Package->GetAssets().Num());
+	if (OnLoaded)
+		Pending.Callbacks.Add(OnLoaded);
+
+	if (!PendingLoadsTickerHandle.IsValid())
+	{
+#if ENGINE_MAJOR_VERSION >= 5
+		PendingLoadsTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UArticyDatabase::TickPendingPackageLoads));
+#else
+		PendingLoadsTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UArticyDatabase::TickPendingPackageLoads));
+#endif
+	}
+}
+
+bool UArticyDatabase::TickPendingPackageLoads(float DeltaTime)
+{
+	//the database asset itself always works on copies, only runtime instances share the package assets
+	const bool bCopyOnWrite = UArticyPluginSettings::Get()->bUseCopyOnWriteObjects && !IsAsset();
+	const double EndTime = FPlatformTime::Seconds() + UArticyPluginSettings::Get()->AsyncLoadBudgetMs / 1000.0;
+
+	TArray<FString> FinishedPackages;
+	for (auto& Entry : PendingPackageLoads)
+	{
+		FArticyPendingPackageLoad& Pending = Entry.Value;
+		if (!Pending.Package)
+		{
+			//the package asset is gone, nothing left to load
+			FinishedPackages.Add(Entry.Key);
 			continue;
+		}
+
+		const auto& Assets = Pending.Package->GetAssets();
+		while (Pending.NextAssetIndex < Assets.Num() && FPlatformTime::Seconds() < EndTime)
+		{
+			if (auto CloneContainer = CreateCloneContainer(Assets[Pending.NextAssetIndex], bCopyOnWrite))
+				Pending.Containers.Add(CloneContainer);
+			++Pending.NextAssetIndex;
+		}
+
+		if (Pending.NextAssetIndex >= Assets.Num())
+			FinishedPackages.Add(Entry.Key);
+
+		if (FPlatformTime::Seconds() >= EndTime)
+			break;
+	}
+
+	for (const FString& PackageName : FinishedPackages)
+	{
+		const FArticyPendingPackageLoad* Pending = PendingPackageLoads.Find(PackageName);
+		FinishPendingPackageLoad(PackageName, Pending && Pending->Package);
+	}
+
+	if (PendingPackageLoads.Num() > 0)
+		return true;
+
+	PendingLoadsTickerHandle.Reset();
+	return false;
+}
+
+void UArticyDatabase::FinishPendingPackageLoad(const FString& PackageName, bool bSucceeded)
+{
+	FArticyPendingPackageLoad Pending;
+	if (!PendingPackageLoads.RemoveAndCopyValue(PackageName, Pending))
+		return;
+
+	if (bSucceeded && !LoadedPackages.Contains(PackageName))
+	{
+		CommitLoadedPackage(PackageName, Pending.Containers);
+	}
+	else
+	{
+		for (auto CloneContainer : Pending.Containers)
+		{
+			if (CloneContainer)
+				CloneContainer->ReleaseShared();
+		}
+
+		if (!bSucceeded)
+			UE_LOG(LogArticyRuntime, Log, TEXT("Loading package %s was cancelled."), *PackageName);
+	}
+
+	//callbacks are called last, they might already request the next package
+	for (const auto& Callback : Pending.Callbacks)
+		Callback(PackageName, bSucceeded);
+}
+
+UArticyCloneableObject* UArticyDatabase::CreateCloneContainer(UArticyObject* ArticyObject, const bool bCopyOnWrite)
+{
+	if (!ArticyObject)
+		return nullptr;
 
-		auto CloneContainer = NewObject<UArticyCloneableObject>(this);
+	auto CloneContainer = NewObject<UArticyCloneableObject>(this);
+	if(bCopyOnWrite)
+	{
+		CloneContainer->InitShared(ArticyObject);
+	}
+	else
+	{
 		UArticyObject* InitialClone = DuplicateObject<UArticyObject>(ArticyObject, this);
 		CloneContainer->Init(InitialClone);
-		
+	}
+
+	return CloneContainer;
+}
+
+void UArticyDatabase::CommitLoadedPackage(const FString& PackageName, const TArray<UArticyCloneableObject*>& Containers)
+{
+	LoadedObjectsById.Reserve(LoadedObjectsById.Num() + Containers.Num());
+
+	for (auto CloneContainer : Containers)
+	{
+		UArticyObject* ArticyObject = CloneContainer ? CloneContainer->Get(this, 0, true) : nullptr;
+		if (!ArticyObject)
+			continue;
+
+		auto id = FArticyId(ArticyObject->GetId());
+
+		//checked here for both LoadPackage and LoadPackageAsync, another package might have been loaded in the meantime
+		if (!ensureMsgf(!LoadedObjectsById.Contains(id), TEXT("Object with id [%d,%d] already in list!"), id.High, id.Low))
+		{
+			CloneContainer->ReleaseShared();
+			continue;
+		}
+
 		LoadedObjectsById.Add(id, CloneContainer);
 
+		AddToClassIndex(CloneContainer, ArticyObject->GetClass());
+
 		if (!ArticyObject->GetTechnicalName().ToString().IsEmpty())
 		{
 			LoadedObjectsByName.FindOrAdd(ArticyObject->GetTechnicalName()).Objects.Add(CloneContainer);
 		}
 	}
 
+	if (auto Package = ImportedPackages.FindRef(PackageName))
+		AddFlowGraph(PackageName, Package->GetFlowGraph());
+
 	LoadedPackages.Add(PackageName);
 	UE_LOG(LogArticyRuntime, Log, TEXT("Package %s loaded successfully."), *PackageName);
 }
 
+void UArticyDatabase::AddFlowGraph(const FString& PackageName, const FArticyFlowGraph& Graph)
+{
+	const int32 PackageIndex = FlowGraphPackageNames.AddUnique(PackageName);
+	LoadedFlowGraphNodes.Reserve(LoadedFlowGraphNodes.Num() + Graph.Nodes.Num() + Graph.Pins.Num());
+
+	//nodes contained in multiple packages keep the location they were first loaded with
+	for (int32 i = 0; i < Graph.Nodes.Num(); ++i)
+	{
+		if (!LoadedFlowGraphNodes.Contains(Graph.Nodes[i].Id))
+			LoadedFlowGraphNodes.Add(Graph.Nodes[i].Id, FArticyFlowGraphEntry{ PackageIndex, i, false });
+	}
+
+	for (int32 i = 0; i < Graph.Pins.Num(); ++i)
+	{
+		if (!LoadedFlowGraphNodes.Contains(Graph.Pins[i].Id))
+			LoadedFlowGraphNodes.Add(Graph.Pins[i].Id, FArticyFlowGraphEntry{ PackageIndex, i, true });
+	}
+}
+
+void UArticyDatabase::RemoveFlowGraph(const FString& PackageName, const FArticyFlowGraph& Graph)
+{
+	const int32 PackageIndex = FlowGraphPackageNames.Find(PackageName);
+	if (PackageIndex == INDEX_NONE)
+		return;
+
+	auto RemoveEntry = [&](const FArticyId& Id)
+	{
+		const auto Entry = LoadedFlowGraphNodes.Find(Id);
+		if (Entry && Entry->PackageIndex == PackageIndex)
+			LoadedFlowGraphNodes.Remove(Id);
+	};
+
+	for (const auto& Node : Graph.Nodes)
+		RemoveEntry(Node.Id);
+	for (const auto& Pin : Graph.Pins)
+		RemoveEntry(Pin.Id);
+}
+
+bool UArticyDatabase::FindInFlowGraph(const FArticyId& Id, FArticyFlowGraphLocation& OutLocation) const
+{
+	const auto Entry = LoadedFlowGraphNodes.Find(Id);
+	if (!Entry)
+		return false;
+
+	//the graph is looked up again each time, the package (and its graph) may have been reimported since it was loaded
+	const auto Package = ImportedPackages.FindRef(FlowGraphPackageNames[Entry->PackageIndex]);
+	if (!Package)
+		return false;
+
+	const auto& Graph = Package->GetFlowGraph();
+	const bool bIsValid = Entry->bIsPin
+		? Graph.Pins.IsValidIndex(Entry->Index) && Graph.Pins[Entry->Index].Id == Id
+		: Graph.Nodes.IsValidIndex(Entry->Index) && Graph.Nodes[Entry->Index].Id == Id;
+	if (!bIsValid)
+		return false;
+
+	OutLocation.Graph = &Graph;
+	OutLocation.Index = Entry->Index;
+	OutLocation.bIsPin = Entry->bIsPin;
+	return true;
+}
+
 bool UArticyDatabase::UnloadPackage(const FString PackageName, const bool bQuickUnload)
 {
+	//a package which is still loading has no loaded objects yet, cancelling the load counts as unloading it
+	if(PendingPackageLoads.Contains(PackageName))
+	{
+		FinishPendingPackageLoad(PackageName, false);
+		return true;
+	}
+
 	if(!LoadedPackages.Contains(PackageName))
 	{
 		UE_LOG(LogArticyRuntime, Log, TEXT("Package %s can't be unloaded due to not being loaded in the first place."), *PackageName);
@@ -336,6 +649,10 @@ bool UArticyDatabase::UnloadPackage(const FString PackageName, const bool bQuick
 
 	UArticyPackage* Package = ImportedPackages[PackageName];	
 
+	//removed from the class index in one pass per class once all are known
+	TSet<UArticyCloneableObject*> UnloadedObjects;
+	TSet<const UClass*> UnloadedClasses;
+
 	for(auto ArticyObject : Package->GetAssets())
 	{
 		FArticyId ArticyId = ArticyObject->GetId();
@@ -370,11 +687,24 @@ bool UArticyDatabase::UnloadPackage(const FString PackageName, const bool bQuick
 
 		if(bShouldUnload)
 		{
-			LoadedObjectsById.FindAndRemoveChecked(ArticyId);
+			UArticyCloneableObject* CloneContainer = LoadedObjectsById.FindAndRemoveChecked(ArticyId);
+			if(CloneContainer)
+			{
+				CloneContainer->ReleaseShared();
+				UnloadedObjects.Add(CloneContainer);
+				UnloadedClasses.Add(ArticyObject->GetClass());
+			}
 			LoadedObjectsByName.FindAndRemoveChecked(TechnicalName);
 		}
 	}
 
+	for(const UClass* Class : UnloadedClasses)
+	{
+		if(auto ClassObjects = LoadedObjectsByClass.Find(Class))
+			ClassObjects->RemoveAll([&](UArticyCloneableObject* Object) { return UnloadedObjects.Contains(Object); });
+	}
+
+	RemoveFlowGraph(Package->Name, Package->GetFlowGraph());
 	LoadedPackages.Remove(Package->Name);
 	UE_LOG(LogArticyRuntime, Log, TEXT("Package %s unloaded successfully."), *PackageName);
 
@@ -383,9 +713,57 @@ bool UArticyDatabase::UnloadPackage(const FString PackageName, const bool bQuick
 
 void UArticyDatabase::UnloadAllPackages()
 {
+	TArray<FString> PendingPackages;
+	PendingPackageLoads.GenerateKeyArray(PendingPackages);
+	for(const FString& PackageName : PendingPackages)
+		FinishPendingPackageLoad(PackageName, false);
+
+	for(const auto& Entry : LoadedObjectsById)
+	{
+		if(Entry.Value)
+			Entry.Value->ReleaseShared();
+	}
+
 	LoadedPackages.Reset();
 	LoadedObjectsById.Reset();
 	LoadedObjectsByName.Reset();
+	LoadedObjectsByClass.Reset();
+	ResetIndexedClassesCache();
+	LoadedFlowGraphNodes.Reset();
+	FlowGraphPackageNames.Reset();
+}
+
+void UArticyDatabase::BeginDestroy()
+{
+	if (PendingLoadsTickerHandle.IsValid())
+	{
+#if ENGINE_MAJOR_VERSION >= 5
+		FTSTicker::GetCoreTicker().RemoveTicker(PendingLoadsTickerHandle);
+#else
+		FTicker::GetCoreTicker().RemoveTicker(PendingLoadsTickerHandle);
+#endif
+		PendingLoadsTickerHandle.Reset();
+	}
+
+	//nobody is left to receive the loaded objects
+	PendingPackageLoads.Reset();
+
+	Super::BeginDestroy();
+}
+
+void UArticyDatabase::PostDuplicate(bool bDuplicateForPIE)
+{
+	Super::PostDuplicate(bDuplicateForPIE);
+
+	//the class index is not serialized, rebuild it for the duplicated objects
+	LoadedObjectsByClass.Reset();
+	ResetIndexedClassesCache();
+	for (const auto& Entry : LoadedObjectsById)
+	{
+		UArticyObject* ArticyObject = Entry.Value ? Entry.Value->Get(this, 0, true) : nullptr;
+		if (ArticyObject)
+			AddToClassIndex(Entry.Value, ArticyObject->GetClass());
+	}
 }
 
 void UArticyDatabase::SetExpressoScriptsClass(TSubclassOf<UArticyExpressoScripts> NewClass)
@@ -489,6 +867,11 @@ void UArticyDatabase::ChangePackageDefault(FName PackageName, bool bIsDefaultPac
 
 //---------------------------------------------------------------------------//
 
+bool UArticyDatabase::UsesPropertyUndoLog() const
+{
+	return UArticyPluginSettings::Get()->bUseUndoLogForShadowStates;
+}
+
 UArticyObject* UArticyDatabase::GetObject(FArticyId Id, int32 CloneId, TSubclassOf<class UArticyObject> CastTo) const
 {
 	return GetObjectInternal(Id, CloneId);
@@ -532,14 +915,15 @@ TArray<UArticyObject*> UArticyDatabase::GetObjects(FName TechnicalName, int32 Cl
 TArray<UArticyObject*> UArticyDatabase::GetObjectsOfClass(TSubclassOf<class UArticyObject> Type, int32 CloneId) const
 {
 	TArray<UArticyObject*> arr;
-	TArray<UArticyCloneableObject*> Objects;
-	LoadedObjectsById.GenerateValueArray(Objects);
+	if (!Type)
+		return arr;
 
-	for (auto ClonableObject : Objects)
+	const TArticyObjectsOfClassView<UArticyObject> View(this, GetIndexedClasses(Type), CloneId, /*bForceUnshadowed = */ true);
+	arr.Reserve(View.NumObjects());
+	for (auto obj : View)
 	{
-		auto obj = ClonableObject->Get(this, CloneId, /*bForceUnshadowed = */ true);
-		if (obj && (obj->GetCloneId() == CloneId) && obj->IsA(Type))
-			arr.Add(Cast<UArticyObject>(obj));
+		if (obj->GetCloneId() == CloneId)
+			arr.Add(obj);
 	}
 
 	return arr;
@@ -548,16 +932,77 @@ TArray<UArticyObject*> UArticyDatabase::GetObjectsOfClass(TSubclassOf<class UArt
 TArray<UArticyObject*> UArticyDatabase::GetAllObjects() const
 {
 	TArray<UArticyObject*> arr;
-	TArray<UArticyCloneableObject*> Objects;
-	LoadedObjectsById.GenerateValueArray(Objects);
-	for (auto ClonableObject : Objects)
+	arr.Reserve(LoadedObjectsById.Num());
+	for (const auto& Entry : LoadedObjectsById)
 	{
-		auto obj = ClonableObject->Get(this, 0, /*bForceUnshadowed = */ true);
-			arr.Add(obj);
+		auto obj = Entry.Value->Get(this, 0, /*bForceUnshadowed = */ true);
+		arr.Add(obj);
 	}
 	return arr;
 }
 
+void UArticyDatabase::AddToClassIndex(UArticyCloneableObject* CloneContainer, const UClass* Class)
+{
+	if (auto ClassObjects = LoadedObjectsByClass.Find(Class))
+	{
+		ClassObjects->Add(CloneContainer);
+		return;
+	}
+
+	LoadedObjectsByClass.Add(Class).Add(CloneContainer);
+	//adding a class moves the arrays, and the new class might match cached queries
+	ResetIndexedClassesCache();
+}
+
+void UArticyDatabase::ResetIndexedClassesCache()
+{
+	FWriteScopeLock WriteLock(IndexedClassesLock);
+	IndexedClassesCache.Reset();
+}
+
+TArticyObjectsOfClassView<UArticyObject>::FClassObjects UArticyDatabase::GetIndexedClasses(const UClass* Class) const
+{
+	//returned as a copy, as another thread might add to the cache in the meantime
+	{
+		FReadScopeLock ReadLock(IndexedClassesLock);
+		if (auto Cached = IndexedClassesCache.Find(Class))
+			return *Cached;
+	}
+
+	//only done once per queried class until the next class is loaded, classes without loaded objects are cached as well
+	FWriteScopeLock WriteLock(IndexedClassesLock);
+	if (auto Cached = IndexedClassesCache.Find(Class))
+		return *Cached;
+
+	TArticyObjectsOfClassView<UArticyObject>::FClassObjects Classes;
+	for (const auto& Entry : LoadedObjectsByClass)
+	{
+		if (Entry.Key->IsChildOf(Class))
+			Classes.Add(&Entry.Value);
+	}
+
+	IndexedClassesCache.Add(Class, Classes);
+	return Classes;
+}
+
+UArticyObject* UArticyDatabase::GetClone(UArticyCloneableObject* CloneContainer, int32 CloneId, EArticyCloneMode CloneMode) const
+{
+	if (!CloneContainer)
+		return nullptr;
+
+	//clones and shadow copies are new objects, which can only be created on the game thread
+	if (!IsInGameThread())
+	{
+		ensureMsgf(CloneMode == EArticyCloneMode::ExistingOnly, TEXT("Clones can only be created on the game thread!"));
+		return CloneContainer->Get(this, CloneId, /*bForceUnshadowed = */ true);
+	}
+
+	if (CloneMode == EArticyCloneMode::CreateMissing)
+		return CloneContainer->Clone(this, CloneId, /*bFailIfExists = */ false);
+
+	return CloneContainer->Get(this, CloneId);
+}
+
 //---------------------------------------------------------------------------//
 
 UArticyObject* UArticyDatabase::CloneFrom(FArticyId Id, int32 NewCloneId, TSubclassOf<class UArticyObject> CastTo)
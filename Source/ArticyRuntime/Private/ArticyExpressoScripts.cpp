@@ -5,80 +5,96 @@
 #include "ArticyExpressoScripts.h"
 #include "ArticyRuntimeModule.h"
 #include "ArticyFlowPlayer.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/StableSort.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeRWLock.h"
 
 TMap<FName, ExpressoType::Definition> ExpressoType::Definitions;
+TMap<TTuple<const UClass*, FName>, ExpressoType::PropertyHandle> ExpressoType::PropertyHandles;
+FRWLock ExpressoType::PropertyHandlesLock;
+const FString ExpressoType::EmptyString;
 
-ExpressoType::ExpressoType() {}
-ExpressoType::~ExpressoType() {}
+#if !UE_BUILD_SHIPPING
+std::atomic<int64> ExpressoType::NumStringPayloads { 0 };
+#define COUNT_STRING_PAYLOAD() NumStringPayloads.fetch_add(1, std::memory_order_relaxed)
+#else
+#define COUNT_STRING_PAYLOAD()
+#endif
 
-ExpressoType::ExpressoType(UArticyBaseObject* Object, const FString& Property)
-{
-	auto propName = Property;
-	Object = TryFeatureReroute(Object, propName);
+ExpressoType::ExpressoType(UArticyBaseObject* Object, const FString& Property) : ExpressoType(Object, FArticyPropertyPath{ Property }) {}
 
-	if (!Object)
-		return;
-
-	auto prop = Object->GetProperty(*propName);
-	if (!ensure(prop))
+ExpressoType::ExpressoType(UArticyBaseObject* Object, const FArticyPropertyPath& Property)
+{
+	PropertyHandle handle;
+	if (!ResolveProperty(Object, Property, handle))
 		return;
 
-	FString itemType;
-	FName type = *prop->GetCPPType(&itemType);
-
-	auto factory = GetDefinition(type).Factory;
-	if (ensureMsgf(factory, TEXT("Property %s has unknown type %s!"), *propName, *type.ToString()))
-		*this = factory(Object, prop);
+	auto& factory = handle.Def->Factory;
+	if (ensureMsgf(factory, TEXT("Property %s has unknown type %s!"), *Property.Path, *handle.Property->GetCPPType()))
+		*this = factory(Object, handle.Property);
 }
 
 //---------------------------------------------------------------------------//
 
-ExpressoType::ExpressoType(const bool& Value)
+ExpressoType::ExpressoType(const FString& Value)
 {
-	BoolValue = Value;
-	Type = Bool;
+	COUNT_STRING_PAYLOAD();
+	StringPayload = new FStringPayload{ Value };
+	Type = String;
 }
 
-ExpressoType::ExpressoType(const int64& Value)
+ExpressoType::ExpressoType(FString&& Value)
 {
-	IntValue = Value;
-	Type = Int;
+	COUNT_STRING_PAYLOAD();
+	StringPayload = new FStringPayload{ MoveTemp(Value) };
+	Type = String;
 }
 
-ExpressoType::ExpressoType(const double& Value)
+void ExpressoType::ReleaseString()
 {
-	FloatValue = Value;
-	Type = Float;
+	if (StringPayload->RefCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		delete StringPayload;
+	Type = Undefined;
 }
 
-ExpressoType::ExpressoType(const FString& Value)
+FString& ExpressoType::GetString()
 {
-	StringValue = Value;
-	Type = String;
+	if (Type != String)
+	{
+		ensureMsgf(Type == Undefined, TEXT("Accessing a non-string ArticyExpressoType as string!"));
+
+		//writes to it are discarded, like the value itself this is never changed into a string
+		static thread_local FString Scratch;
+		Scratch.Reset();
+		return Scratch;
+	}
+
+	if (StringPayload->RefCount.load(std::memory_order_acquire) > 1)
+	{
+		//copy on write
+		*this = ExpressoType(StringPayload->Value);
+	}
+
+	return StringPayload->Value;
 }
 
 //========================================//
 
 ExpressoType::ExpressoType(const UArticyPrimitive* Object)
 {
-	Type = String;
-
 	if (!Object)
 	{
 		// Return "Null" ID to avoid crashes expecting this to be in the %11u_%d format
-		StringValue = "0_0";
+		*this = ExpressoType(FString(TEXT("0_0")));
 		return;
 	}
 
 	// Make sure to use the full 64-bit ID
-	StringValue = FString::Printf(TEXT("%llu_%d"), Object->GetId(), Object->GetCloneId());
+	*this = ExpressoType(FString::Printf(TEXT("%llu_%d"), Object->GetId(), Object->GetCloneId()));
 }
 
-ExpressoType::ExpressoType(const UArticyString& Value)
-{
-	Type = String;
-	StringValue = Value.Get();
-}
+ExpressoType::ExpressoType(const UArticyString& Value) : ExpressoType(Value.Get()) {}
 
 ExpressoType::ExpressoType(const UArticyInt& Value)
 {
@@ -92,66 +108,52 @@ ExpressoType::ExpressoType(const UArticyBool& Value)
 	BoolValue = Value.Get();
 }
 
-ExpressoType::ExpressoType(const FArticyId& Value)
+ExpressoType::ExpressoType(const FArticyGvString& Value) : ExpressoType(Value.Get()) {}
+
+ExpressoType::ExpressoType(const FArticyGvInt& Value)
 {
-	Type = String;
+	Type = Int;
+	IntValue = Value.Get();
+}
+
+ExpressoType::ExpressoType(const FArticyGvBool& Value)
+{
+	Type = Bool;
+	BoolValue = Value.Get();
+}
 
+ExpressoType::ExpressoType(const FArticyId& Value)
+{
 	if (!Value)
 	{
 		// Return "Null" ID to avoid crashes expecting this to be in the %11u_%d format
-		StringValue = "0_0";
+		*this = ExpressoType(FString(TEXT("0_0")));
 		return;
 	}
 
 	// Make sure to use the full 64-bit ID
 	// > always 0 for clone ID... PB...
-	StringValue = FString::Printf(TEXT("%llu_0"), Value.Get());
+	*this = ExpressoType(FString::Printf(TEXT("%llu_0"), Value.Get()));
 }
 
-ExpressoType::operator bool() const
+int64 ExpressoType::ParseObjectId() const
 {
-	ensure(Type == Bool);
-	return GetBool();
-}
-
-ExpressoType::operator int64() const
-{
-	ensure(Type == Float || Type == Int || Type == String);
-
-	if (Type == String)
+	// If we're trying to cast a string to an int64, that likely means we're trying
+	//  to assign an ArticyId via an Articy Primitive (returned by getObj or the like).
+	// In that case, the string should be of the format 0xARTICYID_0xCLONEID
+	// So, split the string along underscores (_)
+	TArray<FString> articyIds;
+	int32 numberOfParts = GetString().ParseIntoArray(articyIds, TEXT("_"), true);
+	if (!ensureMsgf(numberOfParts == 2, TEXT(
+		                "Trying to convert a string to 64-bit integer (such as an Articy ID). "
+		                "Only the result of getObj or similar methods can be assigned to Slots.")))
 	{
-		// If we're trying to cast a string to an int64, that likely means we're trying
-		//  to assign an ArticyId via an Articy Primitive (returned by getObj or the like).
-		// In that case, the string should be of the format 0xARTICYID_0xCLONEID
-		// So, split the string along underscores (_)
-		TArray<FString> articyIds;
-		int32 numberOfParts = GetString().ParseIntoArray(articyIds, TEXT("_"), true);
-		if (!ensureMsgf(numberOfParts == 2, TEXT(
-			                "Trying to convert a string to 64-bit integer (such as an Articy ID). "
-			                "Only the result of getObj or similar methods can be assigned to Slots.")))
-		{
-			// Fail with 0x00000000
-			return 0;
-		}
-
-		// Now, convert
-		return FCString::Atoi64(*articyIds[0]);
+		// Fail with 0x00000000
+		return 0;
 	}
 
-	if (Type == Float)
-		return GetFloat();
-
-	return GetInt();
-}
-
-ExpressoType::operator double() const
-{
-	ensure(Type == Float || Type == Int);
-
-	if (Type == Float)
-		return GetFloat();
-
-	return GetInt();
+	// Now, convert
+	return FCString::Atoi64(*articyIds[0]);
 }
 
 ExpressoType::operator FString() const
@@ -179,313 +181,6 @@ FString ExpressoType::ToString() const
 }
 
 //---------------------------------------------------------------------------//
-//===========================================================================//
-
-ExpressoType ExpressoType::operator-() const
-{
-	switch (Type)
-	{
-	case Undefined:
-		break;
-	case Bool:
-		return ExpressoType(!GetBool());
-	case Int:
-		return ExpressoType(-GetInt());
-	case Float:
-		return ExpressoType(-GetFloat());
-	case String:
-		return ExpressoType(FString(""));
-
-	default:
-		ensureMsgf(false, TEXT("Unknown ArticyExpressoType!"));
-	}
-
-	return ExpressoType{};
-}
-
-//---------------------------------------------------------------------------//
-
-bool ExpressoType::operator==(const ExpressoType& Other) const
-{
-	switch (Type)
-	{
-	case Undefined:
-		break;
-
-	case Bool:
-		return GetBool() == Other.GetBool();
-	case Int:
-		switch (Other.Type)
-		{
-		case Int:
-			return GetInt() == Other.GetInt();
-		case Float:
-			return GetInt() == Other.GetFloat();
-		default:
-			ensureMsgf(false, TEXT("Uncomparable expresso types!"));
-		}
-	case Float:
-		switch (Other.Type)
-		{
-		case Float:
-			return GetFloat() == Other.GetFloat();
-		case Int:
-			return GetFloat() == Other.GetInt();
-		default:
-			ensureMsgf(false, TEXT("Uncomparable expresso types!"));
-		}
-	case String:
-		return GetString() == Other.GetString();
-
-	default:
-		ensureMsgf(false, TEXT("Unknown ArticyExpressoType!"));
-	}
-
-	return false;
-}
-
-bool ExpressoType::operator!=(const ExpressoType& Other) const
-{
-	return !(*this == Other);
-}
-
-bool ExpressoType::operator<(const ExpressoType& Other) const
-{
-	switch (Type)
-	{
-	case Undefined:
-		break;
-
-	case Bool:
-		return GetBool() < Other.GetBool();
-	case Int:
-		switch (Other.Type)
-		{
-		case Int:
-			return GetInt() < Other.GetInt();
-		case Float:
-			return GetInt() < Other.GetFloat();
-		default:
-			ensureMsgf(false, TEXT("Uncomparable expresso types!"));
-		}
-	case Float:
-		switch (Other.Type)
-		{
-		case Float:
-			return GetFloat() < Other.GetFloat();
-		case Int:
-			return GetFloat() < Other.GetInt();
-		default:
-			ensureMsgf(false, TEXT("Uncomparable expresso types!"));
-		}
-	case String:
-		return GetString() < Other.GetString();
-
-	default:
-		ensureMsgf(false, TEXT("Unknown ArticyExpressoType!"));
-	}
-
-	return false;
-}
-
-bool ExpressoType::operator>(const ExpressoType& Other) const
-{
-	switch (Type)
-	{
-	case Undefined:
-		break;
-
-	case Bool:
-		return GetBool() > Other.GetBool();
-	case Int:
-		switch (Other.Type)
-		{
-		case Int:
-			return GetInt() > Other.GetInt();
-		case Float:
-			return GetInt() > Other.GetFloat();
-		default:
-			ensureMsgf(false, TEXT("Uncomparable expresso types!"));
-		}
-	case Float:
-		switch (Other.Type)
-		{
-		case Float:
-			return GetFloat() > Other.GetFloat();
-		case Int:
-			return GetFloat() > Other.GetInt();
-		default:
-			ensureMsgf(false, TEXT("Uncomparable expresso types!"));
-		}
-	case String:
-		return GetString() > Other.GetString();
-
-	default:
-		ensureMsgf(false, TEXT("Unknown ArticyExpressoType!"));
-	}
-
-	return false;
-}
-
-//---------------------------------------------------------------------------//
-
-ExpressoType ExpressoType::operator&&(const ExpressoType& Other) const
-{
-	switch (Type)
-	{
-	case Bool:
-		return ExpressoType(GetBool() && Other.GetBool());
-	case Int:
-		return ExpressoType(GetInt() && Other.GetInt());
-	case Float:
-		return ExpressoType(GetFloat() && Other.GetFloat());
-
-	case String:
-	case Undefined:
-		break;
-
-	default:
-		ensureMsgf(false, TEXT("Unknown ArticyExpressoType!"));
-	}
-
-	return ExpressoType{};
-}
-
-ExpressoType ExpressoType::operator||(const ExpressoType& Other) const
-{
-	switch (Type)
-	{
-	case Bool:
-		return ExpressoType(GetBool() || Other.GetBool());
-	case Int:
-		return ExpressoType(GetInt() || Other.GetInt());
-	case Float:
-		return ExpressoType(GetFloat() || Other.GetFloat());
-
-	case String:
-	case Undefined:
-		break;
-
-	default:
-		ensureMsgf(false, TEXT("Unknown ArticyExpressoType!"));
-	}
-
-	return ExpressoType{};
-}
-
-ExpressoType ExpressoType::operator^(const ExpressoType& Other) const
-{
-	switch (Type)
-	{
-	case Bool:
-		return ExpressoType(GetBool() ^ Other.GetBool());
-	case Int:
-		return ExpressoType(GetInt() ^ Other.GetInt());
-
-	case Float:
-	case String:
-	case Undefined:
-		break;
-
-	default:
-		ensureMsgf(false, TEXT("Unknown ArticyExpressoType!"));
-	}
-
-	return ExpressoType{};
-}
-
-ExpressoType ExpressoType::operator+(const ExpressoType& Other) const
-{
-	switch (Type)
-	{
-	case Undefined:
-		break;
-
-	case Bool:
-		return ExpressoType(GetBool() || Other.GetBool());
-	case Int:
-		return ExpressoType(GetInt() + Other.GetInt());
-	case Float:
-		return ExpressoType(GetFloat() + Other.GetFloat());
-	case String:
-		return ExpressoType(GetString() + Other.GetString());
-
-	default:
-		ensureMsgf(false, TEXT("Unknown ArticyExpressoType!"));
-	}
-
-	return ExpressoType{};
-}
-
-ExpressoType ExpressoType::operator-(const ExpressoType& Other) const
-{
-	return *this + (-Other);
-}
-
-ExpressoType ExpressoType::operator*(const ExpressoType& Other) const
-{
-	switch (Type)
-	{
-	case Bool:
-		return *this && Other;
-	case Int:
-		return ExpressoType(GetInt() * Other.GetInt());
-	case Float:
-		return ExpressoType(GetFloat() * Other.GetFloat());
-
-	case String:
-	case Undefined:
-		break;
-
-	default:
-		ensureMsgf(false, TEXT("Unknown ArticyExpressoType!"));
-	}
-
-	return ExpressoType{};
-}
-
-ExpressoType ExpressoType::operator/(const ExpressoType& Other) const
-{
-	switch (Type)
-	{
-	case Int:
-		return ExpressoType(GetInt() / Other.GetInt());
-	case Float:
-		return ExpressoType(GetFloat() / Other.GetFloat());
-
-	case Bool:
-	case String:
-	case Undefined:
-		break;
-
-	default:
-		ensureMsgf(false, TEXT("Unknown ArticyExpressoType!"));
-	}
-
-	return ExpressoType{};
-}
-
-ExpressoType ExpressoType::operator%(const ExpressoType& Other) const
-{
-	switch (Type)
-	{
-	case Int:
-		return ExpressoType(GetInt() % Other.GetInt());
-	case Float:
-		float OutIntPart;
-		return ExpressoType(FMath::Modf(GetFloat(), &OutIntPart));
-
-	case Bool:
-	case String:
-	case Undefined:
-		break;
-
-	default:
-		ensureMsgf(false, TEXT("Unknown ArticyExpressoType!"));
-	}
-
-	return ExpressoType{};
-}
 
 /*
 ExpressoType& ExpressoType::operator++()
@@ -517,7 +212,7 @@ ExpressoType ExpressoType::operator--(int)
 
 //---------------------------------------------------------------------------//
 
-const ExpressoType::Definition& ExpressoType::GetDefinition(const FName& CppType) const
+const ExpressoType::Definition& ExpressoType::GetDefinition(const FName& CppType)
 {
 	if (Definitions.Num() == 0)
 	{
@@ -556,101 +251,139 @@ const ExpressoType::Definition& ExpressoType::GetDefinition(const FName& CppType
 	return Empty;
 }
 
-void ExpressoType::SetValue(UArticyBaseObject* Object, FString Property) const
+void ExpressoType::SetValue(UArticyBaseObject* Object, const FString& Property) const
 {
-	Object = TryFeatureReroute(Object, Property);
+	SetValue(Object, FArticyPropertyPath{ Property });
+}
 
-	if (!Object)
+void ExpressoType::SetValue(UArticyBaseObject* Object, const FArticyPropertyPath& Property) const
+{
+	//shared objects are copied before the first write
+	if (Object)
+	{
+		auto Writable = Object->PrepareForWrite();
+		if (!Writable)
+			return;
+		Object = Cast<UArticyBaseObject>(Writable->_getUObject());
+	}
+
+	PropertyHandle handle;
+	if (!ResolveProperty(Object, Property, handle))
 		return;
 
-	auto prop = Object->GetProperty(*Property);
-	if (!ensure(prop))
+	auto& setter = handle.Def->Setter;
+	if (ensureMsgf(setter, TEXT("Property %s has unknown type %s!"), *Property.Path, *handle.Property->GetCPPType()))
 	{
-		UE_LOG(LogArticyRuntime, Warning, TEXT("Property %s not found on Object %s!"), *Property, *Object->GetName());
-		return;
+		IShadowStateManager::RecordPropertyChange(Object, handle.Property);
+		setter(Object, handle.Property, *this);
 	}
+}
 
-	FString itemType;
-	FName type = *prop->GetCPPType(&itemType);
+bool ExpressoType::ResolveProperty(UArticyBaseObject*& Object, const FArticyPropertyPath& Path, PropertyHandle& OutHandle)
+{
+	if (!Object)
+		return false;
 
-	auto setter = GetDefinition(type).Setter;
+	//shared objects which were already copied are accessed through the copy
+	Object = Cast<UArticyBaseObject>(Object->GetReadTarget()->_getUObject());
 
-	if (ensureMsgf(setter, TEXT("Property %s has unknown type %s!"), *Property, *type.ToString()))
-		setter(Object, prop, *this);
-}
+	if (!Path.Feature.IsNone())
+	{
+		//the property table of the class is cached already
+		FProperty* featureProperty = Object->GetProperty(Path.Feature);
+		UArticyBaseFeature* Feature = featureProperty ? *featureProperty->ContainerPtrToValuePtr<UArticyBaseFeature*>(Object) : nullptr;
+		if (!ensure(Feature))
+		{
+			UE_LOG(LogArticyRuntime, Warning, TEXT("Feature of path %s on Object %s is null, cannot access property %s!"),
+			       *Path.Path, *Object->GetName(), *Path.Property.ToString());
+			return false;
+		}
 
-UArticyBaseObject* ExpressoType::TryFeatureReroute(UArticyBaseObject* Object, FString& Property)
-{
-	if (Object)
+		Object = Feature;
+	}
+
+	//the handle is copied out, so other threads can replace it in the meantime
+	const UClass* targetClass = Object->GetObjectClass();
+	const auto key = MakeTuple(targetClass, Path.Property);
+	bool bFound = false;
 	{
-		FString feature;
-		if (Property.Split(TEXT("."), &feature, &Property))
+		FReadScopeLock ReadLock(PropertyHandlesLock);
+		if (const PropertyHandle* handle = PropertyHandles.Find(key))
 		{
-			//the property contains a dot
-			//take the part before the dot to extract the feature, and use it as Object to get the actual property from
-			UArticyBaseFeature* Feature = Object->GetProp<UArticyBaseFeature*>(*feature);
-			if (!ensure(Feature))
-			{
-				UE_LOG(LogArticyRuntime, Warning, TEXT("Feature %s on Object %s is null, cannot access property %s!"),
-				       *feature, *Object->GetName(), *Property);
-				return nullptr;
-			}
-
-			return Feature;
+			bFound = handle->Class.Get() == targetClass;
+			if (bFound)
+				OutHandle = *handle;
 		}
 	}
 
-	return Object;
-}
+	if (!bFound)
+	{
+		OutHandle.Class = targetClass;
+		OutHandle.Property = Object->GetProperty(Path.Property);
 
-bool& ExpressoType::GetBool() { return BoolValue; }
-const bool& ExpressoType::GetBool() const { return BoolValue; }
+		//the definitions are filled on first use as well
+		FWriteScopeLock WriteLock(PropertyHandlesLock);
+		OutHandle.Def = OutHandle.Property ? &GetDefinition(*OutHandle.Property->GetCPPType()) : nullptr;
+		PropertyHandles.Add(key, OutHandle);
+	}
 
-int64& ExpressoType::GetInt() { return IntValue; }
-const int64& ExpressoType::GetInt() const { return IntValue; }
+	if (!ensure(OutHandle.Property))
+	{
+		UE_LOG(LogArticyRuntime, Warning, TEXT("Property %s not found on Object %s!"), *Path.Path, *Object->GetName());
+		return false;
+	}
 
-double& ExpressoType::GetFloat() { return FloatValue; }
-const double& ExpressoType::GetFloat() const { return FloatValue; }
+	return true;
+}
 
-FString& ExpressoType::GetString() { return StringValue; }
-const FString& ExpressoType::GetString() const { return StringValue; }
+FArticyPropertyPath::FArticyPropertyPath(const FString& InPath) : Path(InPath)
+{
+	//the property contains a dot, the part before the dot is the feature which holds the actual property
+	FString feature, property;
+	if (Path.Split(TEXT("."), &feature, &property))
+	{
+		Feature = *feature;
+		Property = *property;
+	}
+	else
+	{
+		Property = *Path;
+	}
+}
 
-ExpressoType::ExpressoType(const int32& Value) : ExpressoType(int64(Value)) {}
-ExpressoType::ExpressoType(const int16& Value) : ExpressoType(int64(Value)) {}
-ExpressoType::ExpressoType(const int8& Value) : ExpressoType(int64(Value)) {}
-ExpressoType::ExpressoType(const uint64& Value) : ExpressoType(int64(Value)) {}
-ExpressoType::ExpressoType(const uint32& Value) : ExpressoType(int64(Value)) {}
-ExpressoType::ExpressoType(const uint16& Value) : ExpressoType(int64(Value)) {}
-ExpressoType::ExpressoType(const uint8& Value) : ExpressoType(int64(Value)) {}
-ExpressoType::ExpressoType(const float& Value) : ExpressoType(double(Value)) {}
 ExpressoType::ExpressoType(const FText& Value) : ExpressoType(Value.ToString()) {}
 ExpressoType::ExpressoType(const FName& Value) : ExpressoType(Value.ToString()) {}
 
-ExpressoType::operator int8() const { return int64(*this); }
-ExpressoType::operator uint8() const { return int64(*this); }
-ExpressoType::operator int16() const { return int64(*this); }
-ExpressoType::operator uint16() const { return int64(*this); }
-ExpressoType::operator int32() const { return int64(*this); }
-ExpressoType::operator uint32() const { return int64(*this); }
-ExpressoType::operator uint64() const { return int64(*this); }
-ExpressoType::operator float() const { return double(*this); }
 ExpressoType::operator FText() const { return FText::FromString(FString(*this)); }
 ExpressoType::operator FName() const { return *FString(*this); }
 ExpressoType::operator FArticyId() const { return int64(*this); }
 
-bool ExpressoType::operator<=(const ExpressoType& Other) const { return !(*this > Other); }
-bool ExpressoType::operator>=(const ExpressoType& Other) const { return !(*this < Other); }
 
 //---------------------------------------------------------------------------//
 
 bool UArticyExpressoScripts::Evaluate(const int& ConditionFragmentHash, UArticyGlobalVariables* GV,
                                       UObject* MethodProvider) const
 {
+	return Evaluate(INDEX_NONE, ConditionFragmentHash, GV, MethodProvider);
+}
+
+bool UArticyExpressoScripts::Execute(const int& InstructionFragmentHash, UArticyGlobalVariables* GV,
+                                     UObject* MethodProvider) const
+{
+	return Execute(INDEX_NONE, InstructionFragmentHash, GV, MethodProvider);
+}
+
+bool UArticyExpressoScripts::Evaluate(int32 ConditionIndex, const int& ConditionFragmentHash, UArticyGlobalVariables* GV,
+                                      UObject* MethodProvider) const
+{
+	if (auto entry = FindEntry(GetConditionTable(), ConditionIndex, ConditionFragmentHash))
+		return Dispatch(*entry, GV, MethodProvider);
+
 	SetGV(GV);
 	UserMethodsProvider = MethodProvider;
 
 	auto condition = Conditions.Find(ConditionFragmentHash);
-	bool result = ensure(condition) && (*condition)();
+	const bool result = ensure(condition) && (*condition)();
 
 	// Clear methods provider
 	UserMethodsProvider = nullptr;
@@ -658,9 +391,15 @@ bool UArticyExpressoScripts::Evaluate(const int& ConditionFragmentHash, UArticyG
 	return result;
 }
 
-bool UArticyExpressoScripts::Execute(const int& InstructionFragmentHash, UArticyGlobalVariables* GV,
+bool UArticyExpressoScripts::Execute(int32 InstructionIndex, const int& InstructionFragmentHash, UArticyGlobalVariables* GV,
                                      UObject* MethodProvider) const
 {
+	//notify all changes of the instruction at once, after it is done
+	FArticyGvChangeBatch ChangeBatch(GV);
+
+	if (auto entry = FindEntry(GetInstructionTable(), InstructionIndex, InstructionFragmentHash))
+		return Dispatch(*entry, GV, MethodProvider);
+
 	SetGV(GV);
 	UserMethodsProvider = MethodProvider;
 
@@ -678,6 +417,64 @@ bool UArticyExpressoScripts::Execute(const int& InstructionFragmentHash, UArticy
 	return result;
 }
 
+TArray<FArticyExpressoDispatchEntry> UArticyExpressoScripts::MergeDispatchTables(std::initializer_list<TArrayView<const FArticyExpressoDispatchEntry>> Shards)
+{
+	TArray<FArticyExpressoDispatchEntry> Table;
+	for (const auto& Shard : Shards)
+		Table.Append(Shard.GetData(), Shard.Num());
+
+	//fragments with equal hashes are always in the same shard, in the order the indices were assigned on import
+	Algo::StableSortBy(Table, &FArticyExpressoDispatchEntry::Hash);
+	return Table;
+}
+
+int32 UArticyExpressoScripts::FindInTable(TArrayView<const FArticyExpressoDispatchEntry> Table, uint32 Hash)
+{
+	const int32 index = Algo::LowerBoundBy(Table, Hash, &FArticyExpressoDispatchEntry::Hash);
+	return Table.IsValidIndex(index) && Table[index].Hash == Hash ? index : INDEX_NONE;
+}
+
+EArticyExpressoFragmentUsage UArticyExpressoScripts::GetConditionUsage(int32 ConditionIndex, uint32 ConditionFragmentHash) const
+{
+	auto entry = FindEntry(GetConditionTable(), ConditionIndex, ConditionFragmentHash);
+	return entry ? entry->Usage : EArticyExpressoFragmentUsage::All;
+}
+
+EArticyExpressoFragmentUsage UArticyExpressoScripts::GetInstructionUsage(int32 InstructionIndex, uint32 InstructionFragmentHash) const
+{
+	auto entry = FindEntry(GetInstructionTable(), InstructionIndex, InstructionFragmentHash);
+	return entry ? entry->Usage : EArticyExpressoFragmentUsage::All;
+}
+
+const FArticyExpressoDispatchEntry* UArticyExpressoScripts::FindEntry(TArrayView<const FArticyExpressoDispatchEntry> Table, int32 Index, uint32 Hash)
+{
+	//the index stored on import might be out of date if the scripts were not recompiled
+	if (!Table.IsValidIndex(Index) || Table[Index].Hash != Hash)
+		Index = FindInTable(Table, Hash);
+
+	return Index != INDEX_NONE ? &Table[Index] : nullptr;
+}
+
+bool UArticyExpressoScripts::Dispatch(const FArticyExpressoDispatchEntry& Entry, UArticyGlobalVariables* GV, UObject* MethodProvider) const
+{
+	const bool bUsesGV = EnumHasAnyFlags(Entry.Usage, EArticyExpressoFragmentUsage::GlobalVariables);
+	const bool bUsesMethods = EnumHasAnyFlags(Entry.Usage, EArticyExpressoFragmentUsage::UserMethods);
+
+	if (bUsesGV)
+		SetGV(GV);
+	if (bUsesMethods)
+		UserMethodsProvider = MethodProvider;
+
+	//fragments are not const, just like the lambdas they replace
+	const bool result = Entry.Function(const_cast<UArticyExpressoScripts*>(this));
+
+	if (bUsesMethods)
+		UserMethodsProvider = nullptr;
+	if (bUsesGV)
+		SetGV(nullptr);
+	return result;
+}
+
 UArticyObject* UArticyExpressoScripts::getObj(const FString& NameOrId, const uint32& CloneId) const
 {
 	if (NameOrId.StartsWith(TEXT("0x")))
@@ -734,22 +531,43 @@ void UArticyExpressoScripts::setProp(UArticyBaseObject* Object, const FString& P
 	Value.SetValue(Object, Property);
 }
 
+void UArticyExpressoScripts::setProp(UArticyBaseObject* Object, const FArticyPropertyPath& Property, const ExpressoType& Value)
+{
+	Value.SetValue(Object, Property);
+}
+
 void UArticyExpressoScripts::setProp(const ExpressoType& Id_CloneId, const FString& Property,
                                      const ExpressoType& Value) const
 {
 	setProp(getObjInternal(Id_CloneId), Property, Value);
 }
 
+void UArticyExpressoScripts::setProp(const ExpressoType& Id_CloneId, const FArticyPropertyPath& Property,
+                                     const ExpressoType& Value) const
+{
+	setProp(getObjInternal(Id_CloneId), Property, Value);
+}
+
 ExpressoType UArticyExpressoScripts::getProp(UArticyBaseObject* Object, const FString& Property)
 {
 	return ExpressoType{Object, Property};
 }
 
+ExpressoType UArticyExpressoScripts::getProp(UArticyBaseObject* Object, const FArticyPropertyPath& Property)
+{
+	return ExpressoType{Object, Property};
+}
+
 ExpressoType UArticyExpressoScripts::getProp(const ExpressoType& Id_CloneId, const FString& Property) const
 {
 	return getProp(getObjInternal(Id_CloneId), Property);
 }
 
+ExpressoType UArticyExpressoScripts::getProp(const ExpressoType& Id_CloneId, const FArticyPropertyPath& Property) const
+{
+	return getProp(getObjInternal(Id_CloneId), Property);
+}
+
 int UArticyExpressoScripts::random(int Min, int Max)
 {
 	return FMath::RandRange(Min, Max);
@@ -867,3 +685,63 @@ bool UArticyExpressoScripts::isPropInRange(const ExpressoType& Id_CloneId, const
 {
 	return isPropInRange(getObjInternal(Id_CloneId), Property, lowerBound, upperBound);
 }
+
+//---------------------------------------------------------------------------//
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Evaluates expressions like the ones in generated expresso scripts, and reports the time
+ * and the number of string payloads allocated per evaluation.
+ */
+struct FArticyExpressoBenchmark
+{
+	static void Run(const TArray<FString>& Args)
+	{
+		const int32 NumEvaluations = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 1000000;
+
+		const ExpressoType Counter{ 7 };
+		const ExpressoType Threshold{ 20.5 };
+		const ExpressoType Flag{ true };
+		const ExpressoType Name{ FString(TEXT("Hero")) };
+
+		auto Measure = [&](const TCHAR* Label, auto&& Evaluate)
+		{
+			int64 Result = 0;
+			const int64 PayloadsBefore = ExpressoType::NumStringPayloads.load(std::memory_order_relaxed);
+			const double Start = FPlatformTime::Seconds();
+
+			for (int32 i = 0; i < NumEvaluations; ++i)
+				Result += Evaluate(i) ? 1 : 0;
+
+			const double Seconds = FPlatformTime::Seconds() - Start;
+			const int64 Payloads = ExpressoType::NumStringPayloads.load(std::memory_order_relaxed) - PayloadsBefore;
+
+			UE_LOG(LogArticyRuntime, Display, TEXT("%s: %.2f ns and %.3f string payloads per evaluation (%lld true)."),
+				Label, Seconds * 1e9 / NumEvaluations, double(Payloads) / NumEvaluations, Result);
+		};
+
+		//numbers and bools never allocate
+		Measure(TEXT("Numeric"), [&](int32 i)
+		{
+			return (Counter + ExpressoType{ i }) * ExpressoType{ 2 } > Threshold && Flag;
+		});
+
+		//comparing strings shares the payload, only building a new string allocates one
+		Measure(TEXT("String compare"), [&](int32)
+		{
+			return Name == ExpressoType{ Name };
+		});
+		Measure(TEXT("String concat"), [&](int32)
+		{
+			return !(Name + Name).GetString().IsEmpty();
+		});
+	}
+};
+
+static FAutoConsoleCommand GArticyExpressoBenchmarkCommand(
+	TEXT("ArticyRuntime.ExpressoBenchmark"),
+	TEXT("Evaluates expresso values [count] times and logs the time and string allocations per evaluation."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&FArticyExpressoBenchmark::Run));
+
+#endif
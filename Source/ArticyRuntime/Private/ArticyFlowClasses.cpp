@@ -37,7 +37,7 @@ void UArticyJump::Explore(UArticyFlowPlayer* Player, TArray<FArticyBranch>& OutB
 	if(pin)
 	{
 		const auto bShadowed = false;
-		OutBranches.Append( Player->Explore(pin, bShadowed, Depth + 1) );
+		Player->Explore(pin, bShadowed, Depth + 1, OutBranches);
 	}
 	else
 	{
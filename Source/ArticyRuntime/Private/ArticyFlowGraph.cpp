@@ -0,0 +1,136 @@
+//  
+// Copyright (c) 2023 articy Software GmbH & Co. KG. All rights reserved.  
+//
+
+#include "ArticyFlowGraph.h"
+#include "ArticyObject.h"
+#include "ArticyPins.h"
+#include "ArticyBuiltinTypes.h"
+#include "ArticyFlowClasses.h"
+#include "ArticyScriptFragment.h"
+#include "Interfaces/ArticyInputPinsProvider.h"
+#include "Interfaces/ArticyOutputPinsProvider.h"
+
+void FArticyFlowGraph::Build(const TArray<UArticyObject*>& Assets)
+{
+	Nodes.Reset();
+	Pins.Reset();
+	Connections.Reset();
+
+	TMap<FArticyId, int32> PinIndexById;
+	TArray<TArray<FArticyId>> PinTargets;
+
+	auto AddPin = [&](UArticyFlowPin* Pin, int32 NodeIndex, int32 PinIndex, bool bIsInput)
+	{
+		auto& GraphPin = Pins.AddDefaulted_GetRef();
+		GraphPin.Id = Pin->GetId();
+		GraphPin.Node = NodeIndex;
+		GraphPin.PinIndex = PinIndex;
+		GraphPin.bIsInput = bIsInput;
+		GraphPin.bHasScript = Pin->HasScript();
+		GraphPin.ScriptHash = Pin->GetScriptHash();
+		GraphPin.ScriptIndex = Pin->ScriptIndex;
+
+		PinIndexById.Add(GraphPin.Id, Pins.Num() - 1);
+
+		//connections are added once all pins are known
+		auto& Targets = PinTargets.AddDefaulted_GetRef();
+		for(auto Connection : Pin->Connections)
+		{
+			if(Connection)
+				Targets.Add(Connection->GetTargetPinID());
+		}
+	};
+
+	for(auto Asset : Assets)
+	{
+		auto FlowObject = Cast<IArticyFlowObject>(Asset);
+		//pins are added together with their owner
+		if(!FlowObject || Cast<UArticyFlowPin>(Asset))
+			continue;
+
+		const int32 NodeIndex = Nodes.Num();
+		auto& Node = Nodes.AddDefaulted_GetRef();
+		Node.Id = Asset->GetId();
+		Node.Type = static_cast<uint8>(FlowObject->GetType());
+
+		if(auto Condition = Cast<UArticyCondition>(Asset))
+		{
+			Node.Kind = EArticyFlowGraphNodeKind::Condition;
+			if(auto Script = Condition->GetCondition())
+			{
+				Node.bHasScript = !Script->GetExpression().IsEmpty();
+				Node.ScriptHash = Script->GetExpressionHash();
+				Node.ScriptIndex = Script->GetFragmentIndex();
+			}
+		}
+		else if(auto Instruction = Cast<UArticyInstruction>(Asset))
+		{
+			Node.Kind = EArticyFlowGraphNodeKind::Instruction;
+			if(auto Script = Instruction->GetInstruction())
+			{
+				Node.bHasScript = !Script->GetExpression().IsEmpty();
+				Node.ScriptHash = Script->GetExpressionHash();
+				Node.ScriptIndex = Script->GetFragmentIndex();
+			}
+		}
+		else if(auto Jump = Cast<UArticyJump>(Asset))
+		{
+			Node.Kind = EArticyFlowGraphNodeKind::Jump;
+			Node.JumpTarget = Connections.Num();
+			Connections.AddDefaulted_GetRef().TargetPinId = Jump->GetTargetPinID();
+		}
+
+		Node.FirstPin = Pins.Num();
+		if(auto InputPinsProvider = Cast<IArticyInputPinsProvider>(Asset))
+		{
+			if(auto InputPins = InputPinsProvider->GetInputPinsPtr())
+			{
+				for(int32 i = 0; i < InputPins->Num(); ++i)
+				{
+					if(ensure((*InputPins)[i]))
+						AddPin((*InputPins)[i], NodeIndex, i, true);
+				}
+			}
+		}
+		Nodes[NodeIndex].NumInputPins = Pins.Num() - Nodes[NodeIndex].FirstPin;
+
+		if(auto OutputPinsProvider = Cast<IArticyOutputPinsProvider>(Asset))
+		{
+			if(auto OutputPins = OutputPinsProvider->GetOutputPinsPtr())
+			{
+				for(int32 i = 0; i < OutputPins->Num(); ++i)
+				{
+					if(ensure((*OutputPins)[i]))
+						AddPin((*OutputPins)[i], NodeIndex, i, false);
+				}
+			}
+		}
+		Nodes[NodeIndex].NumOutputPins = Pins.Num() - Nodes[NodeIndex].GetFirstOutputPin();
+	}
+
+	//store the connections of each pin contiguously, targets in other packages are resolved at runtime
+	for(int32 i = 0; i < Pins.Num(); ++i)
+	{
+		Pins[i].FirstConnection = Connections.Num();
+		Pins[i].NumConnections = PinTargets[i].Num();
+
+		for(const auto& TargetPinId : PinTargets[i])
+		{
+			const int32* TargetPin = PinIndexById.Find(TargetPinId);
+			auto& Connection = Connections.AddDefaulted_GetRef();
+			Connection.TargetPinId = TargetPinId;
+			Connection.TargetPin = TargetPin ? *TargetPin : INDEX_NONE;
+		}
+	}
+
+	for(const auto& Node : Nodes)
+	{
+		if(Node.JumpTarget != INDEX_NONE)
+		{
+			auto& Jump = Connections[Node.JumpTarget];
+			const int32* TargetPin = PinIndexById.Find(Jump.TargetPinId);
+			Jump.TargetPin = TargetPin ? *TargetPin : INDEX_NONE;
+		}
+	}
+}
@@ -6,6 +6,9 @@
 #include "ArticyRuntimeModule.h"
 #include "Interfaces/ArticyFlowObject.h"
 #include "Interfaces/ArticyObjectWithSpeaker.h"
+#include "Interfaces/ArticyObjectWithPreviewImage.h"
+#include "ArticyAsset.h"
+#include "Engine/StreamableManager.h"
 #include "ArticyExpressoScripts.h"
 #include "UObject/ConstructorHelpers.h"
 #include "Interfaces/ArticyInputPinsProvider.h"
@@ -13,6 +16,17 @@
 #include "Engine/Texture2D.h"
 
 
+bool FArticyBranchCacheKey::ReadValuesUnchanged() const
+{
+	for(const auto& ReadValue : ReadValues)
+	{
+		if(!ReadValue.Key.IsValid() || ReadValue.Key->GetExpressoValue() != ReadValue.Value)
+			return false;
+	}
+
+	return true;
+}
+
 TScriptInterface<IArticyFlowObject> FArticyBranch::GetTarget() const
 {
 	return Path.Num() > 0 ? Path.Last() : nullptr;
@@ -181,31 +195,90 @@ UObject* UArticyFlowPlayer::GetMethodsProvider() const
 IArticyFlowObject* UArticyFlowPlayer::GetUnshadowedNode(IArticyFlowObject* Node)
 {
 	auto db = UArticyDatabase::Get(this);
-	UArticyPrimitive* UnshadowedObject = db->GetObjectUnshadowed(Cast<UArticyPrimitive>(Node)->GetId());
+
+	//nodes retrieved outside of a shadow state (or with the property undo log) are never shadow copies
+	if (!db->IsInShadowState() || db->UsesPropertyUndoLog())
+		return Node;
+
+	auto targetId = Cast<UArticyPrimitive>(Node)->GetId();
+	if (auto cached = UnshadowedNodes.Find(targetId))
+		return *cached;
+
+	UArticyPrimitive* UnshadowedObject = db->GetObjectUnshadowed(targetId);
 
 	// handle pins, because we can not request them directly from the db 
 	if (!UnshadowedObject)
 	{
 		auto pinOwner = db->GetObjectUnshadowed(Cast<UArticyFlowPin>(Node)->GetOwner()->GetId());
 
-		TArray<UArticyFlowPin*> pins;
-		auto inputPinsOwner = Cast<IArticyInputPinsProvider>(pinOwner);
-		pins.Append(*inputPinsOwner->GetInputPinsPtr());
-		auto outputPinsOwner = Cast<IArticyOutputPinsProvider>(pinOwner);
-		pins.Append(*outputPinsOwner->GetOutputPinsPtr());
-
-		auto targetId = Cast<UArticyPrimitive>(Node)->GetId();
-		for (auto pin : pins)
+		auto findPin = [&](const auto* pins)
 		{
-			if (pin->GetId() == targetId)
+			if (pins)
 			{
-				UnshadowedObject = pin;
-				break;
+				for (auto pin : *pins)
+				{
+					if (pin && pin->GetId() == targetId)
+					{
+						UnshadowedObject = pin;
+						return;
+					}
+				}
 			}
+		};
+
+		if (auto inputPinsOwner = Cast<IArticyInputPinsProvider>(pinOwner))
+			findPin(inputPinsOwner->GetInputPinsPtr());
+		if (!UnshadowedObject)
+		{
+			if (auto outputPinsOwner = Cast<IArticyOutputPinsProvider>(pinOwner))
+				findPin(outputPinsOwner->GetOutputPinsPtr());
 		}
 	}
 
-	return Cast<IArticyFlowObject>(UnshadowedObject);
+	auto UnshadowedNode = Cast<IArticyFlowObject>(UnshadowedObject);
+	UnshadowedNodes.Add(targetId, UnshadowedNode);
+	return UnshadowedNode;
+}
+
+int32 UArticyFlowPlayer::AddExploreNode(IArticyFlowObject* Node)
+{
+	return ExploreArena.Add(FArticyExploreNode{ GetUnshadowedNode(Node), ExploreParent });
+}
+
+int32 UArticyFlowPlayer::AddGraphExploreNode(const FArticyFlowGraphLocation& Location)
+{
+	return ExploreArena.Add(FArticyExploreNode{ nullptr, ExploreParent, Location });
+}
+
+void UArticyFlowPlayer::MaterializePaths(TArray<FArticyBranch>& Branches)
+{
+	for (auto& branch : Branches)
+	{
+		int32 length = 0;
+		for (int32 i = branch.ExploreLeaf; i != INDEX_NONE; i = ExploreArena[i].Parent)
+			++length;
+
+		//fill the path back to front, following the parent links from the leaf to the root
+		branch.Path.Reset(length);
+		branch.Path.SetNum(length);
+		for (int32 i = branch.ExploreLeaf; i != INDEX_NONE; i = ExploreArena[i].Parent)
+		{
+			//nodes of the flow graph are resolved once, branches share their common nodes
+			auto& exploreNode = ExploreArena[i];
+			if (!exploreNode.Node && exploreNode.GraphLocation.Graph)
+			{
+				exploreNode.Node = GetGraphObject(exploreNode.GraphLocation, true);
+				exploreNode.GraphLocation.Graph = nullptr;
+			}
+
+			auto node = exploreNode.Node;
+			auto& ptr = branch.Path[--length];
+			ptr.SetObject(node ? node->_getUObject() : nullptr);
+			ptr.SetInterface(node);
+		}
+
+		branch.ExploreLeaf = INDEX_NONE;
+	}
 }
 
 //---------------------------------------------------------------------------//
@@ -214,6 +287,44 @@ TArray<FArticyBranch> UArticyFlowPlayer::Explore(IArticyFlowObject* Node, bool b
 {
 	TArray<FArticyBranch> OutBranches;
 
+	//nested calls (i.e. from a node's Explore) are part of the running exploration,
+	//their paths are materialized once the outermost call is done
+	const bool bIsOutermost = !bIsExploring;
+	if (bIsOutermost)
+	{
+		bIsExploring = true;
+		ExploreArena.Reset();
+		UnshadowedNodes.Reset();
+	}
+
+	//walk the precompiled flow graph if the node is part of a loaded package
+	FArticyFlowGraphLocation GraphLocation;
+	bool bInFlowGraph = false;
+	if (bIsOutermost && bUseFlowGraph)
+	{
+		if (auto obj = Cast<UArticyPrimitive>(Node))
+			bInFlowGraph = GetDB()->FindInFlowGraph(obj->GetId(), GraphLocation);
+	}
+
+	if (bInFlowGraph)
+		ExploreGraph(GraphLocation, bShadowed, Depth, OutBranches, IncludeCurrent);
+	else
+		Explore(Node, bShadowed, Depth, OutBranches, IncludeCurrent);
+
+	if (bIsOutermost)
+	{
+		MaterializePaths(OutBranches);
+		bIsExploring = false;
+	}
+
+	return OutBranches;
+}
+
+void UArticyFlowPlayer::Explore(IArticyFlowObject* Node, bool bShadowed, int32 Depth, TArray<FArticyBranch>& OutBranches, bool IncludeCurrent)
+{
+	if (!ensureMsgf(bIsExploring, TEXT("Explore with OutBranches can only be called during an exploration!")))
+		return;
+
 	//check stop condition
 	if((Depth > ExploreLimit || !Node || (Node != Cursor.GetInterface() && ShouldPauseOn(Node))))
 	{
@@ -230,7 +341,7 @@ TArray<FArticyBranch> UArticyFlowPlayer::Explore(IArticyFlowObject* Node, bool b
 		}*/
 
 		//target reached, create a branch
-		auto branch = FArticyBranch{};
+		auto& branch = OutBranches.AddDefaulted_GetRef();
 		if(Node)
 		{
 			/* NOTE: This check must not be done, as the last node in a branch never affects
@@ -238,15 +349,8 @@ TArray<FArticyBranch> UArticyFlowPlayer::Explore(IArticyFlowObject* Node, bool b
 			* with invalid condition, instead of just UP TO that node.
 			branch.bIsValid = Node->Execute(this); */
 
-			auto unshadowedNode = GetUnshadowedNode(Node);
-
-			TScriptInterface<IArticyFlowObject> ptr;
-			ptr.SetObject(unshadowedNode->_getUObject());
-			ptr.SetInterface(unshadowedNode);
-			branch.Path.Add(ptr);
+			branch.ExploreLeaf = AddExploreNode(Node);
 		}
-
-		OutBranches.Add(branch);
 	}
 	else
 	{
@@ -270,6 +374,17 @@ TArray<FArticyBranch> UArticyFlowPlayer::Explore(IArticyFlowObject* Node, bool b
 			}
 		}
 
+		// add this node to the search tree, it becomes the parent of all nodes explored from here
+		// 
+		// Only do this if IncludeCurrent is true. 
+		// See https://github.com/ArticySoftware/ArticyImporterForUnreal/issues/50
+		const int32 NodeIndex = IncludeCurrent ? AddExploreNode(Node) : INDEX_NONE;
+		const int32 PreviousParent = ExploreParent;
+		if (IncludeCurrent)
+			ExploreParent = NodeIndex;
+
+		const int32 FirstBranch = OutBranches.Num();
+
 		//if this is the first node, try to submerge
 		bool bSubmerged = false;
 		if(Depth == 0)
@@ -294,25 +409,321 @@ TArray<FArticyBranch> UArticyFlowPlayer::Explore(IArticyFlowObject* Node, bool b
 			}
 		}
 
-		// add this node to the head of all the branches
-		// 
-		// Only do this if IncludeCurrent is true. 
-		// See https://github.com/ArticySoftware/ArticyImporterForUnreal/issues/50
-		if (IncludeCurrent)
+		//dead-ends found below this node end at this node
+		for (int32 i = FirstBranch; i < OutBranches.Num(); ++i)
+		{
+			if (OutBranches[i].ExploreLeaf == INDEX_NONE)
+				OutBranches[i].ExploreLeaf = NodeIndex;
+		}
+
+		ExploreParent = PreviousParent;
+	}
+}
+
+//---------------------------------------------------------------------------//
+
+IArticyFlowObject* UArticyFlowPlayer::GetGraphObject(const FArticyFlowGraphLocation& Location, bool bUnshadowed)
+{
+	auto db = GetDB();
+	const auto& graph = *Location.Graph;
+	const FArticyId& id = Location.bIsPin ? graph.Pins[Location.Index].Id : graph.Nodes[Location.Index].Id;
+
+	//outside of a shadow state (or with the property undo log) there are no shadow copies
+	bUnshadowed = bUnshadowed && db->IsInShadowState() && !db->UsesPropertyUndoLog();
+	if (bUnshadowed)
+	{
+		if (auto cached = UnshadowedNodes.Find(id))
+			return *cached;
+	}
+
+	UArticyPrimitive* obj = nullptr;
+	if (!Location.bIsPin)
+	{
+		obj = bUnshadowed ? db->GetObjectUnshadowed(id) : db->GetObject(id);
+	}
+	else
+	{
+		//pins can not be requested from the db directly, but the graph knows where to find them
+		const auto& pin = graph.Pins[Location.Index];
+		const FArticyId& ownerId = graph.Nodes[pin.Node].Id;
+		UArticyPrimitive* owner = bUnshadowed ? db->GetObjectUnshadowed(ownerId) : db->GetObject(ownerId);
+
+		const TArray<UArticyInputPin*>* inputPins = nullptr;
+		const TArray<UArticyOutputPin*>* outputPins = nullptr;
+		if (pin.bIsInput)
+		{
+			if (auto inputPinsOwner = Cast<IArticyInputPinsProvider>(owner))
+				inputPins = inputPinsOwner->GetInputPinsPtr();
+			if (inputPins && inputPins->IsValidIndex(pin.PinIndex))
+				obj = (*inputPins)[pin.PinIndex];
+		}
+		else
+		{
+			if (auto outputPinsOwner = Cast<IArticyOutputPinsProvider>(owner))
+				outputPins = outputPinsOwner->GetOutputPinsPtr();
+			if (outputPins && outputPins->IsValidIndex(pin.PinIndex))
+				obj = (*outputPins)[pin.PinIndex];
+		}
+	}
+
+	auto node = Cast<IArticyFlowObject>(obj);
+	if (bUnshadowed)
+		UnshadowedNodes.Add(id, node);
+	return node;
+}
+
+bool UArticyFlowPlayer::ShouldPauseOnGraph(const FArticyFlowGraphLocation& Location) const
+{
+	const uint8 type = Location.bIsPin ? uint8(EArticyPausableType::Pin) : Location.Graph->Nodes[Location.Index].Type;
+	return (PauseOn & (1 << type)) != 0;
+}
+
+bool UArticyFlowPlayer::IsGraphCursor(const FArticyFlowGraphLocation& Location) const
+{
+	const auto cursor = Cast<UArticyPrimitive>(Cursor.GetObject());
+	if (!cursor)
+		return false;
+
+	const auto& graph = *Location.Graph;
+	return cursor->GetId() == (Location.bIsPin ? graph.Pins[Location.Index].Id : graph.Nodes[Location.Index].Id);
+}
+
+bool UArticyFlowPlayer::RunGraphScript(const FArticyFlowGraphLocation& Location, bool bIsCondition)
+{
+	const auto& graph = *Location.Graph;
+	const bool bHasScript = Location.bIsPin ? graph.Pins[Location.Index].bHasScript : graph.Nodes[Location.Index].bHasScript;
+	const int32 hash = Location.bIsPin ? graph.Pins[Location.Index].ScriptHash : graph.Nodes[Location.Index].ScriptHash;
+	const int32 index = Location.bIsPin ? graph.Pins[Location.Index].ScriptIndex : graph.Nodes[Location.Index].ScriptIndex;
+
+	//empty conditions are always true, empty instructions do nothing
+	if (!bHasScript)
+		return true;
+
+	auto xp = GetDB()->GetExpressoInstance();
+	if (!ensure(xp))
+		return true;
+
+	//set current object and speaker on expresso scripts, unless the script does not use them
+	const auto usage = bIsCondition ? xp->GetConditionUsage(index, hash) : xp->GetInstructionUsage(index, hash);
+	auto obj = EnumHasAnyFlags(usage, EArticyExpressoFragmentUsage::CurrentObject)
+		? Cast<UArticyPrimitive>(GetGraphObject(Location, false)) : nullptr;
+	if (obj)
+	{
+		xp->SetCurrentObject(obj);
+
+		IArticyObjectWithSpeaker* speaker;
+		if (auto flowPin = Cast<UArticyFlowPin>(obj))
+			speaker = Cast<IArticyObjectWithSpeaker>(flowPin->GetOwner());
+		else
+			speaker = Cast<IArticyObjectWithSpeaker>(obj);
+
+		if (speaker)
+			xp->SetSpeaker(speaker->GetSpeaker());
+	}
+
+	return bIsCondition
+		? xp->Evaluate(index, hash, GetGVs(), GetMethodsProvider())
+		: xp->Execute(index, hash, GetGVs(), GetMethodsProvider());
+}
+
+bool UArticyFlowPlayer::ResolveGraphConnection(const FArticyFlowGraph& Graph, int32 ConnectionIndex, FArticyFlowGraphLocation& OutTarget) const
+{
+	const auto& connection = Graph.Connections[ConnectionIndex];
+	if (connection.TargetPin != INDEX_NONE)
+	{
+		OutTarget.Graph = &Graph;
+		OutTarget.Index = connection.TargetPin;
+		OutTarget.bIsPin = true;
+		return true;
+	}
+
+	//the target is in another package, which has to be loaded as well
+	return GetDB()->FindInFlowGraph(connection.TargetPinId, OutTarget) && OutTarget.bIsPin;
+}
+
+void UArticyFlowPlayer::ExploreGraphConnection(const FArticyFlowGraph& Graph, int32 ConnectionIndex, bool bShadowed, int32 Depth, TArray<FArticyBranch>& OutBranches)
+{
+	FArticyFlowGraphLocation target;
+	if (ResolveGraphConnection(Graph, ConnectionIndex, target))
+	{
+		ExploreGraph(target, bShadowed, Depth, OutBranches);
+	}
+	else
+	{
+		UE_LOG(LogArticyRuntime, Warning, TEXT("Found a nullptr Node when exploring a branch!"));
+		OutBranches.AddDefaulted();
+	}
+}
+
+void UArticyFlowPlayer::ExploreGraphOutputPins(const FArticyFlowGraph& Graph, int32 NodeIndex, int32 PinDepth, TArray<FArticyBranch>& OutBranches)
+{
+	const auto& node = Graph.Nodes[NodeIndex];
+	if (node.NumOutputPins > 0)
+	{
+		//shadow needed?
+		const bool bShadowed = node.NumOutputPins > 1;
+
+		for (int32 i = node.GetFirstOutputPin(); i < node.GetFirstOutputPin() + node.NumOutputPins; ++i)
+			ExploreGraph(FArticyFlowGraphLocation{ &Graph, i, true }, bShadowed, PinDepth, OutBranches);
+	}
+	else
+	{
+		//DEAD-END!
+		OutBranches.AddDefaulted();
+	}
+}
+
+void UArticyFlowPlayer::ExploreGraphNode(const FArticyFlowGraphLocation& Location, int32 Depth, TArray<FArticyBranch>& OutBranches)
+{
+	const auto& graph = *Location.Graph;
+
+	if (Location.bIsPin)
+	{
+		const auto& pin = graph.Pins[Location.Index];
+		const FArticyFlowGraphLocation owner{ &graph, pin.Node, false };
+
+		if (!pin.bIsInput)
 		{
-			for (auto& branch : OutBranches)
+			RunGraphScript(Location, false);
+
+			if (pin.NumConnections > 0)
 			{
-				auto unshadowedNode = GetUnshadowedNode(Node);
-				TScriptInterface<IArticyFlowObject> ptr;
-				ptr.SetObject(unshadowedNode->_getUObject());
-				ptr.SetInterface(unshadowedNode);
+				const bool bShadowed = pin.NumConnections > 1;
+				for (int32 i = pin.FirstConnection; i < pin.FirstConnection + pin.NumConnections; ++i)
+					ExploreGraphConnection(graph, i, bShadowed, Depth + 1, OutBranches);
+			}
+			else
+			{
+				//DEAD-END!
+				OutBranches.AddDefaulted();
+			}
+			return;
+		}
+
+		//see UArticyInputPin::Explore
+		const bool bIsValid = RunGraphScript(Location, true);
+		const int32 FirstBranch = OutBranches.Num();
+
+		if (!bIsValid && IgnoresInvalidBranches())
+			return;
+
+		if (Depth > 3 && ShouldPauseOnGraph(owner))
+		{
+			ExploreGraph(owner, false, Depth + 1, OutBranches);
+		}
+		else if (pin.NumConnections > 0)
+		{
+			const bool bShadowed = pin.NumConnections > 1;
+			for (int32 i = pin.FirstConnection; i < pin.FirstConnection + pin.NumConnections; ++i)
+				ExploreGraphConnection(graph, i, bShadowed, Depth + 1, OutBranches);
+		}
+		else
+		{
+			ExploreGraph(owner, false, Depth + 1, OutBranches);
+		}
+
+		if (!bIsValid)
+		{
+			for (int32 i = FirstBranch; i < OutBranches.Num(); ++i)
+				OutBranches[i].bIsValid = false;
+		}
+		return;
+	}
+
+	const auto& node = graph.Nodes[Location.Index];
+	switch (node.Kind)
+	{
+	case EArticyFlowGraphNodeKind::Jump:
+	{
+		FArticyFlowGraphLocation target;
+		if (ResolveGraphConnection(graph, node.JumpTarget, target))
+			ExploreGraph(target, false, Depth + 1, OutBranches);
+		else
+			OutBranches.AddDefaulted();
+		break;
+	}
+	case EArticyFlowGraphNodeKind::Condition:
+		if (ensure(node.NumOutputPins == 2))
+		{
+			const int32 pinIndex = node.GetFirstOutputPin() + (RunGraphScript(Location, true) ? 0 : 1);
+			ExploreGraph(FArticyFlowGraphLocation{ &graph, pinIndex, true }, false, Depth + 1, OutBranches);
+		}
+		else
+		{
+			//falls back to UArticyNode::Explore
+			ExploreGraphOutputPins(graph, Location.Index, Depth + 2, OutBranches);
+		}
+		break;
+	case EArticyFlowGraphNodeKind::Instruction:
+		RunGraphScript(Location, false);
+		ExploreGraphOutputPins(graph, Location.Index, Depth + 2, OutBranches);
+		break;
+	default:
+		//UArticyNode::Explore and IArticyOutputPinsProvider::Explore each go one level deeper
+		ExploreGraphOutputPins(graph, Location.Index, Depth + 2, OutBranches);
+		break;
+	}
+}
+
+void UArticyFlowPlayer::ExploreGraph(const FArticyFlowGraphLocation& Location, bool bShadowed, int32 Depth, TArray<FArticyBranch>& OutBranches, bool IncludeCurrent)
+{
+	const auto& graph = *Location.Graph;
+
+	//check stop condition, same as for objects
+	if (Depth > ExploreLimit || (!IsGraphCursor(Location) && ShouldPauseOnGraph(Location)))
+	{
+		if (Depth > ExploreLimit)
+			UE_LOG(LogArticyRuntime, Warning, TEXT("ExploreDepthLimit (%d) reached, stopping exploration!"), ExploreLimit);
+
+		//target reached, create a branch
+		auto& branch = OutBranches.AddDefaulted_GetRef();
+		branch.ExploreLeaf = AddGraphExploreNode(Location);
+		return;
+	}
 
-				branch.Path.Insert(ptr, 0); //TODO inserting at front is not ideal performance wise
+	const int32 NodeIndex = IncludeCurrent ? AddGraphExploreNode(Location) : INDEX_NONE;
+	const int32 PreviousParent = ExploreParent;
+	if (IncludeCurrent)
+		ExploreParent = NodeIndex;
+
+	const int32 FirstBranch = OutBranches.Num();
+
+	//if this is the first node, try to submerge (see IArticyInputPinsProvider::TrySubmerge)
+	bool bSubmerged = false;
+	if (Depth == 0 && !Location.bIsPin)
+	{
+		const auto& node = graph.Nodes[Location.Index];
+		if (node.NumInputPins > 0)
+		{
+			const bool bShadowedSubmerge = bShadowed || node.NumInputPins > 1 || graph.Pins[node.FirstPin].NumConnections > 1;
+			for (int32 i = node.FirstPin; i < node.FirstPin + node.NumInputPins; ++i)
+			{
+				if (graph.Pins[i].NumConnections > 0)
+				{
+					bSubmerged = true;
+					ExploreGraph(FArticyFlowGraphLocation{ &graph, i, true }, bShadowedSubmerge, Depth + 2, OutBranches);
+				}
 			}
 		}
 	}
 
-	return OutBranches;
+	//explore this node
+	if (!bSubmerged)
+	{
+		if (bShadowed)
+			ShadowedOperation([&] { ExploreGraphNode(Location, Depth + 1, OutBranches); });
+		else
+			ExploreGraphNode(Location, Depth + 1, OutBranches);
+	}
+
+	//dead-ends found below this node end at this node
+	for (int32 i = FirstBranch; i < OutBranches.Num(); ++i)
+	{
+		if (OutBranches[i].ExploreLeaf == INDEX_NONE)
+			OutBranches[i].ExploreLeaf = NodeIndex;
+	}
+
+	ExploreParent = PreviousParent;
 }
 
 void UArticyFlowPlayer::SetPauseOn(EArticyPausableType Types)
@@ -334,10 +745,59 @@ void UArticyFlowPlayer::UpdateAvailableBranches()
 	UpdateAvailableBranchesInternal(false);
 }
 
+void UArticyFlowPlayer::PrefetchBranchPreviewImages()
+{
+	auto DB = GetDB();
+	if(!DB)
+		return;
+
+	TArray<const UArticyAsset*> Assets;
+	auto AddPreviewImage = [&](UObject* Object)
+	{
+		auto ObjectWithPreviewImage = Cast<IArticyObjectWithPreviewImage>(Object);
+		auto PreviewImage = ObjectWithPreviewImage ? ObjectWithPreviewImage->GetPreviewImage() : nullptr;
+		if(PreviewImage && !PreviewImage->Asset.IsNull())
+		{
+			if(auto Asset = DB->GetObject<UArticyAsset>(PreviewImage->Asset))
+				Assets.AddUnique(Asset);
+		}
+	};
+
+	for(const auto& Branch : AvailableBranches)
+	{
+		for(const auto& Node : Branch.Path)
+		{
+			AddPreviewImage(Node.GetObject());
+			if(auto ObjectWithSpeaker = Cast<IArticyObjectWithSpeaker>(Node.GetObject()))
+				AddPreviewImage(ObjectWithSpeaker->GetSpeaker());
+		}
+	}
+
+	//the old handle is only released after the new request, so assets used by both stay loaded
+	PrefetchHandle = UArticyAsset::PrefetchAssets(Assets);
+}
+
 //---------------------------------------------------------------------------//
 
 void UArticyFlowPlayer::UpdateAvailableBranchesInternal(bool Startup)
 {
+	//nothing the last exploration depended on changed, the branches are still up to date
+	if(bCacheBranches && !Startup && BranchCache.IsValid()
+		&& BranchCache.Cursor == Cursor.GetObject()
+		&& BranchCache.GVs == GetGVs()
+		&& BranchCache.PauseOn == PauseOn
+		&& BranchCache.bIgnoreInvalidBranches == bIgnoreInvalidBranches
+		&& BranchCache.ExploreLimit == ExploreLimit
+		&& BranchCache.DB == GetDB()
+		&& BranchCache.PropertyChangeCount == GetDB()->GetPropertyChangeCount()
+		&& BranchCache.ReadValuesUnchanged())
+	{
+		OnPlayerPaused.Broadcast(Cursor);
+		OnBranchesUpdated.Broadcast(AvailableBranches);
+		return;
+	}
+
+	InvalidateBranchCache();
 	AvailableBranches.Reset();
 
 	if(PauseOn == 0)
@@ -347,8 +807,34 @@ void UArticyFlowPlayer::UpdateAvailableBranchesInternal(bool Startup)
 	else
 	{
 		const bool bMustBeShadowed = true;
+
+		//remember which variables the exploration depends on
+		//(the startup exploration includes the cursor itself and is never reused)
+		const bool bUpdateCache = bCacheBranches && !Startup;
+		//only reads of this player's GVs are tracked, other players are not affected
+		auto GVs = GetGVs();
+		TSet<const UArticyVariable*> ReadVariables;
+		auto PreviousReadTracker = bUpdateCache && GVs ? GVs->TrackReads(&ReadVariables) : nullptr;
+
 		AvailableBranches = Explore(&*Cursor, bMustBeShadowed, 0, Startup);
 
+		if(bUpdateCache && GVs)
+		{
+			GVs->TrackReads(PreviousReadTracker);
+
+			//all shadow states are popped again, so the values are taken from the live state
+			BranchCache.Cursor = Cursor.GetObject();
+			BranchCache.GVs = GVs;
+			BranchCache.PauseOn = PauseOn;
+			BranchCache.bIgnoreInvalidBranches = bIgnoreInvalidBranches;
+			BranchCache.ExploreLimit = ExploreLimit;
+			BranchCache.DB = GetDB();
+			BranchCache.PropertyChangeCount = BranchCache.DB.IsValid() ? BranchCache.DB->GetPropertyChangeCount() : 0;
+			BranchCache.ReadValues.Reserve(ReadVariables.Num());
+			for(auto Variable : ReadVariables)
+				BranchCache.ReadValues.Emplace(Variable, Variable->GetExpressoValue());
+		}
+
 		// Prune empty branches
 		AvailableBranches.RemoveAllSwap([](const FArticyBranch& branch) { return branch.Path.Num() == 0; });
 
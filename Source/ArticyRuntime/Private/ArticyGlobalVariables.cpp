@@ -72,11 +72,66 @@ const FName& FArticyGvName::GetFullName()
 
 //---------------------------------------------------------------------------//
 
+int32 FArticyGvHandle::GetId(const UArticyGlobalVariables* Store) const
+{
+	//the ids are generated, so the cached id is valid for all global variable instances
+	if(Id == INDEX_NONE)
+		Id = Store->FindVariableId(Name);
+
+	return Id < Store->GetNumVariables() ? Id : INDEX_NONE;
+}
+
+//---------------------------------------------------------------------------//
+
 uint32 UArticyVariable::GetStoreShadowLevel() const
 {
 	return Store->GetShadowLevel();
 }
 
+void UArticyVariable::InitFlat(UArticyBaseVariableSet* Set, UArticyGlobalVariables* const NewStore, const FName& Name, const int32 Slot)
+{
+	GVName = Name;
+	Store = NewStore;
+	FlatSlot = Slot;
+
+	//register the set's OnVariableChanged delegate on the variable's
+	OnVariableChanged.AddDynamic(Set, &UArticyBaseVariableSet::BroadcastOnVariableChanged);
+}
+
+void UArticyVariable::NotifyChanged()
+{
+	//variables which are not registered yet are being initialized
+	if(Id == INDEX_NONE)
+		OnVariableChanged.Broadcast(this);
+	else
+		Store->NotifyValueChanged(Id);
+}
+
+const TArray<UArticyVariable*> UArticyBaseVariableSet::GetVariables() const
+{
+	if(!FlatStore)
+		return Variables;
+
+	TArray<UArticyVariable*> Handles;
+	Handles.Reserve(NumFlatSlots);
+	for(int32 Slot = FirstFlatSlot; Slot < FirstFlatSlot + NumFlatSlots; ++Slot)
+		Handles.Add(FlatStore->GetVariableHandle(Slot));
+
+	return Handles;
+}
+
+UArticyVariable* UArticyBaseVariableSet::FindVariable(const FName Variable)
+{
+	if(FlatStore)
+	{
+		const int32 Slot = FlatStore->GetFlatStorage().FindSlot(FArticyGvName(GetFName(), Variable).GetFullName());
+		return Slot != INDEX_NONE ? FlatStore->GetVariableHandle(Slot) : nullptr;
+	}
+
+	UArticyVariable** Ptr = GetPropPtr<UArticyVariable*>(Variable);
+	return Ptr ? *Ptr : nullptr;
+}
+
 void UArticyBaseVariableSet::BroadcastOnVariableChanged(UArticyVariable* Variable)
 {
 	OnVariableChanged.Broadcast(Variable);
@@ -270,23 +325,23 @@ void UArticyGlobalVariables::PrintGlobalVariable(FArticyGvName GvName)
 	auto set = GetNamespace(GvName.GetNamespace());
 	if(set) 
 	{
-		UArticyVariable** basePtr = set->GetPropPtr<UArticyVariable*>(GvName.GetVariable());
+		UArticyVariable* baseVariable = set->FindVariable(GvName.GetVariable());
 
-		if (Cast<UArticyBool>(*basePtr))
+		if (Cast<UArticyBool>(baseVariable))
 		{
 			bool boolSucceeded = false;
 			auto boolValue = GetBoolVariable(GvName, boolSucceeded);
 			UE_LOG(LogArticyRuntime, Display, TEXT("%s::%s = %s"), *GvName.GetNamespace().ToString(), *GvName.GetVariable().ToString(), boolValue ? *FString("True") : *FString("False"));
 			bPrintSuccessful = true;
 		}
-		else if (Cast<UArticyInt>(*basePtr))
+		else if (Cast<UArticyInt>(baseVariable))
 		{
 			bool intSucceeded = false;
 			auto intValue = GetIntVariable(GvName, intSucceeded);
 			UE_LOG(LogArticyRuntime, Display, TEXT("%s::%s = %d"), *GvName.GetNamespace().ToString(), *GvName.GetVariable().ToString(), intValue);
 			bPrintSuccessful = true;
 		}
-		else if (Cast<UArticyString>(*basePtr))
+		else if (Cast<UArticyString>(baseVariable))
 		{
 			bool stringSucceeded = false;
 			auto stringValue = GetStringVariable(GvName, stringSucceeded);
@@ -334,6 +389,711 @@ void UArticyGlobalVariables::SetStringVariable(FArticyGvName GvName, const FStri
 	SetVariableValue<UArticyString>(GvName.GetNamespace(), GvName.GetVariable(), Value);
 }
 
+const bool& UArticyGlobalVariables::GetBoolVariableByHandle(const FArticyGvHandle& Handle, bool& bSucceeded)
+{
+	return GetVariableValue<UArticyBool, bool>(Handle, bSucceeded);
+}
+
+const int32& UArticyGlobalVariables::GetIntVariableByHandle(const FArticyGvHandle& Handle, bool& bSucceeded)
+{
+	return GetVariableValue<UArticyInt, int32>(Handle, bSucceeded);
+}
+
+const FString& UArticyGlobalVariables::GetStringVariableByHandle(const FArticyGvHandle& Handle, bool& bSucceeded)
+{
+	return GetVariableValue<UArticyString, FString>(Handle, bSucceeded);
+}
+
+void UArticyGlobalVariables::SetBoolVariableByHandle(const FArticyGvHandle& Handle, const bool Value)
+{
+	SetVariableValue<UArticyBool>(Handle, Value);
+}
+
+void UArticyGlobalVariables::SetIntVariableByHandle(const FArticyGvHandle& Handle, const int32 Value)
+{
+	SetVariableValue<UArticyInt>(Handle, Value);
+}
+
+void UArticyGlobalVariables::SetStringVariableByHandle(const FArticyGvHandle& Handle, const FString Value)
+{
+	SetVariableValue<UArticyString>(Handle, Value);
+}
+
+int32 UArticyGlobalVariables::FindVariableId(FArticyGvName GvName) const
+{
+	const FName& FullName = GvName.GetFullName();
+	if(UsesFlatStorage())
+		return FlatStorage.FindSlot(FullName);
+
+	const int32* Id = VariableIds.Find(FullName);
+	return Id ? *Id : INDEX_NONE;
+}
+
+UArticyVariable* UArticyGlobalVariables::GetVariableById(const int32 Id)
+{
+	if(Id < 0 || Id >= GetNumVariables())
+		return nullptr;
+
+	return UsesFlatStorage() ? GetVariableHandle(Id) : VariablesById[Id];
+}
+
+void UArticyGlobalVariables::RegisterVariable(UArticyVariable* Variable)
+{
+	Variable->Id = VariablesById.Add(Variable);
+	VariableIds.Add(Variable->GetGVName(), Variable->Id);
+}
+
+EArticyGvType UArticyGlobalVariables::GetVariableType(const int32 Id) const
+{
+	if(UsesFlatStorage())
+		return FlatStorage.GetSlot(Id).Type;
+
+	if(VariablesById[Id]->IsA<UArticyBool>())
+		return EArticyGvType::Bool;
+	if(VariablesById[Id]->IsA<UArticyInt>())
+		return EArticyGvType::Int;
+	return EArticyGvType::String;
+}
+
+uint32 UArticyGlobalVariables::GetLayoutHash() const
+{
+	//the layout is fixed by the generated code, so it only needs to be hashed once
+	if(LayoutHash.IsSet())
+		return LayoutHash.GetValue();
+
+	//hash the strings, FName hashes are not stable between sessions
+	uint32 Hash = GetTypeHash(GetNumVariables());
+	for(int32 Id = 0; Id < GetNumVariables(); ++Id)
+	{
+		const FName& Name = UsesFlatStorage() ? FlatStorage.GetSlot(Id).Name : VariablesById[Id]->GetGVName();
+		Hash = HashCombine(Hash, HashCombine(GetTypeHash(Name.ToString()), static_cast<uint32>(GetVariableType(Id))));
+	}
+
+	LayoutHash = Hash;
+	return Hash;
+}
+
+template<typename VariableType>
+const typename VariableType::UnderlyingType& UArticyGlobalVariables::PeekValue(const int32 Id) const
+{
+	if(UsesFlatStorage())
+		return FlatStorage.Get<typename VariableType::UnderlyingType>(Id);
+
+	return static_cast<const VariableType*>(VariablesById[Id])->GetValueRef();
+}
+
+static bool IsSameValue(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+template<typename T>
+static bool IsSameValue(const T& A, const T& B) { return A == B; }
+
+template<typename VariableType>
+bool UArticyGlobalVariables::PokeValue(const int32 Id, const typename VariableType::UnderlyingType& NewValue)
+{
+	if(IsSameValue(PeekValue<VariableType>(Id), NewValue))
+		return false;
+
+	if(UsesFlatStorage())
+	{
+		bool bNewShadowLevel = false;
+		FlatStorage.Set(Id, NewValue, 0, bNewShadowLevel);
+	}
+	else
+	{
+		static_cast<VariableType*>(VariablesById[Id])->Value = NewValue;
+	}
+
+	MarkDirty(Id);
+	return true;
+}
+
+void UArticyGlobalVariables::BroadcastValueChanged(const int32 Id)
+{
+	if(UsesFlatStorage())
+	{
+		BroadcastFlatValueChanged(Id);
+		return;
+	}
+
+	auto Variable = VariablesById[Id];
+	Variable->OnVariableChanged.Broadcast(Variable);
+}
+
+void UArticyGlobalVariables::NotifyValueChanged(const int32 Id)
+{
+	MarkDirty(Id);
+
+	if(ChangeBatchDepth > 0)
+	{
+		if(BatchedChangesMask.Num() <= Id)
+			BatchedChangesMask.Add(false, GetNumVariables() - BatchedChangesMask.Num());
+
+		if(!BatchedChangesMask[Id])
+		{
+			BatchedChangesMask[Id] = true;
+			BatchedChanges.Add(Id);
+		}
+		return;
+	}
+
+	BroadcastValueChanged(Id);
+	if(OnVariablesChanged.IsBound())
+		OnVariablesChanged.Broadcast(TArray<UArticyVariable*>{ GetVariableById(Id) });
+}
+
+void UArticyGlobalVariables::BeginChangeBatch()
+{
+	++ChangeBatchDepth;
+}
+
+void UArticyGlobalVariables::EndChangeBatch()
+{
+	//this is called from Blueprints, an unmatched call is reported but not fatal
+	if(ChangeBatchDepth <= 0)
+	{
+		UE_LOG(LogArticyRuntime, Error, TEXT("EndChangeBatch called without matching BeginChangeBatch!"));
+		return;
+	}
+
+	if(--ChangeBatchDepth > 0)
+		return;
+
+	//listeners may change variables again, which are then notified right away
+	TArray<int32> Changes = MoveTemp(BatchedChanges);
+	BatchedChanges.Reset();
+	BatchedChangesMask.Init(false, BatchedChangesMask.Num());
+
+	for(const int32 Id : Changes)
+		BroadcastValueChanged(Id);
+
+	if(Changes.Num() > 0 && OnVariablesChanged.IsBound())
+	{
+		TArray<UArticyVariable*> Variables;
+		Variables.Reserve(Changes.Num());
+		for(const int32 Id : Changes)
+			Variables.Add(GetVariableById(Id));
+
+		OnVariablesChanged.Broadcast(Variables);
+	}
+}
+
+TSet<const UArticyVariable*>* UArticyGlobalVariables::TrackReads(TSet<const UArticyVariable*>* Reads)
+{
+	auto PreviousTracker = ReadTracker;
+	ReadTracker = Reads;
+	return PreviousTracker;
+}
+
+//---------------------------------------------------------------------------//
+// SNAPSHOTS
+//---------------------------------------------------------------------------//
+
+/**
+ * Snapshot format (version 1):
+ *  uint8 version, uint32 layout hash, varint number of variables,
+ *  the bools as bits in id order, the ints as zigzag varints in id order,
+ *  a table of the distinct strings (varint count, then varint UTF-8 length and bytes each),
+ *  and the string variables as varint indices into that table, in id order.
+ *
+ * Delta format (version 1):
+ *  uint8 version, uint32 layout hash, varint number of changed variables,
+ *  then per changed variable in id order: varint distance to the previous id (plus one),
+ *  followed by the value (one byte for bools, a zigzag varint for ints, varint UTF-8 length and bytes for strings).
+ */
+static constexpr uint8 GvSnapshotVersion = 1;
+static constexpr uint8 GvDeltaVersion = 0x81;
+
+static void WriteVarint(TArray<uint8>& Buffer, uint32 Value)
+{
+	while(Value >= 0x80)
+	{
+		Buffer.Add(static_cast<uint8>(Value) | 0x80);
+		Value >>= 7;
+	}
+	Buffer.Add(static_cast<uint8>(Value));
+}
+
+static bool ReadVarint(const TArray<uint8>& Buffer, int32& Offset, uint32& OutValue)
+{
+	OutValue = 0;
+	for(int32 Shift = 0; Shift < 32; Shift += 7)
+	{
+		if(Offset >= Buffer.Num())
+			return false;
+
+		const uint8 Byte = Buffer[Offset++];
+		OutValue |= static_cast<uint32>(Byte & 0x7F) << Shift;
+		if(!(Byte & 0x80))
+			return true;
+	}
+	return false;
+}
+
+static uint32 ZigZagEncode(const int32 Value) { return (static_cast<uint32>(Value) << 1) ^ static_cast<uint32>(Value >> 31); }
+static int32 ZigZagDecode(const uint32 Value) { return static_cast<int32>(Value >> 1) ^ -static_cast<int32>(Value & 1); }
+
+static void WriteString(TArray<uint8>& Buffer, const FString& Value)
+{
+	const FTCHARToUTF8 Utf8(*Value);
+	WriteVarint(Buffer, Utf8.Length());
+	Buffer.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+}
+
+static bool ReadString(const TArray<uint8>& Buffer, int32& Offset, FString& OutValue)
+{
+	uint32 Length = 0;
+	if(!ReadVarint(Buffer, Offset, Length) || Length > static_cast<uint32>(Buffer.Num() - Offset))
+		return false;
+
+	const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Buffer.GetData() + Offset), Length);
+	OutValue = FString(Converted.Length(), Converted.Get());
+	Offset += Length;
+	return true;
+}
+
+/** Compares strings case sensitively, unlike the default key funcs for FString. */
+struct FGvSnapshotStringKeyFuncs : TDefaultMapKeyFuncs<FString, int32, false>
+{
+	static bool Matches(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+	static uint32 GetKeyHash(const FString& Key) { return FCrc::StrCrc32(*Key); }
+};
+
+void UArticyGlobalVariables::WriteSnapshotHeader(TArray<uint8>& Buffer, const uint8 Version, const uint32 Count) const
+{
+	Buffer.Add(Version);
+
+	//little endian, so snapshots can be exchanged between platforms
+	const uint32 Hash = GetLayoutHash();
+	for(int32 Byte = 0; Byte < 4; ++Byte)
+		Buffer.Add(static_cast<uint8>(Hash >> (Byte * 8)));
+	WriteVarint(Buffer, Count);
+}
+
+bool UArticyGlobalVariables::ReadSnapshotHeader(const TArray<uint8>& Buffer, int32& Offset, const uint8 Version, uint32& OutCount) const
+{
+	if(Buffer.Num() < 5 || Buffer[0] != Version)
+	{
+		UE_LOG(LogArticyRuntime, Error, TEXT("Unable to read GV snapshot: unknown format."));
+		return false;
+	}
+
+	uint32 Hash = 0;
+	for(int32 Byte = 0; Byte < 4; ++Byte)
+		Hash |= static_cast<uint32>(Buffer[1 + Byte]) << (Byte * 8);
+	Offset = 5;
+	if(!ReadVarint(Buffer, Offset, OutCount) || Hash != GetLayoutHash())
+	{
+		UE_LOG(LogArticyRuntime, Error, TEXT("Unable to read GV snapshot: it was captured from different global variables."));
+		return false;
+	}
+
+	return true;
+}
+
+TArray<uint8> UArticyGlobalVariables::CaptureSnapshot() const
+{
+	const int32 NumVariables = GetNumVariables();
+
+	TArray<uint8> Buffer;
+	Buffer.Reserve(16 + NumVariables * 2);
+	WriteSnapshotHeader(Buffer, GvSnapshotVersion, NumVariables);
+
+	TArray<int32> StringIndices;
+	TMap<FString, int32, FDefaultSetAllocator, FGvSnapshotStringKeyFuncs> StringTable;
+	TArray<const FString*> Strings;
+
+	uint8 Bits = 0;
+	int32 NumBits = 0;
+	for(int32 Id = 0; Id < NumVariables; ++Id)
+	{
+		if(GetVariableType(Id) != EArticyGvType::Bool)
+			continue;
+
+		Bits |= (PeekValue<UArticyBool>(Id) ? 1 : 0) << NumBits;
+		if(++NumBits == 8)
+		{
+			Buffer.Add(Bits);
+			Bits = 0;
+			NumBits = 0;
+		}
+	}
+	if(NumBits > 0)
+		Buffer.Add(Bits);
+
+	for(int32 Id = 0; Id < NumVariables; ++Id)
+	{
+		switch(GetVariableType(Id))
+		{
+		case EArticyGvType::Int:
+			WriteVarint(Buffer, ZigZagEncode(PeekValue<UArticyInt>(Id)));
+			break;
+		case EArticyGvType::String:
+		{
+			const FString& Value = PeekValue<UArticyString>(Id);
+			const int32* Index = StringTable.Find(Value);
+			StringIndices.Add(Index ? *Index : StringTable.Add(Value, Strings.Add(&Value)));
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	WriteVarint(Buffer, Strings.Num());
+	for(const FString* String : Strings)
+		WriteString(Buffer, *String);
+	for(const int32 Index : StringIndices)
+		WriteVarint(Buffer, Index);
+
+	return Buffer;
+}
+
+bool UArticyGlobalVariables::DecodeSnapshot(const TArray<uint8>& Snapshot, FDecodedSnapshot& OutValues) const
+{
+	int32 Offset = 0;
+	uint32 NumVariables = 0;
+	if(!ReadSnapshotHeader(Snapshot, Offset, GvSnapshotVersion, NumVariables))
+		return false;
+
+	if(NumVariables != static_cast<uint32>(GetNumVariables()))
+	{
+		UE_LOG(LogArticyRuntime, Error, TEXT("Unable to read GV snapshot: it was captured from different global variables."));
+		return false;
+	}
+
+	for(uint32 Id = 0; Id < NumVariables; ++Id)
+	{
+		switch(GetVariableType(Id))
+		{
+		case EArticyGvType::Bool:
+			OutValues.Bools.Add(false);
+			break;
+		case EArticyGvType::Int:
+			OutValues.Ints.Add(0);
+			break;
+		case EArticyGvType::String:
+			OutValues.Strings.AddDefaulted();
+			break;
+		}
+	}
+
+	auto& Bools = OutValues.Bools;
+	bool bValid = Offset + (Bools.Num() + 7) / 8 <= Snapshot.Num();
+	for(int32 i = 0; bValid && i < Bools.Num(); ++i)
+		Bools[i] = (Snapshot[Offset + i / 8] >> (i % 8)) & 1;
+	Offset += (Bools.Num() + 7) / 8;
+
+	for(int32 i = 0; bValid && i < OutValues.Ints.Num(); ++i)
+	{
+		uint32 Value = 0;
+		bValid = ReadVarint(Snapshot, Offset, Value);
+		OutValues.Ints[i] = ZigZagDecode(Value);
+	}
+
+	uint32 NumStrings = 0;
+	TArray<FString> StringTable;
+	bValid = bValid && ReadVarint(Snapshot, Offset, NumStrings) && NumStrings <= static_cast<uint32>(Snapshot.Num());
+	for(uint32 i = 0; bValid && i < NumStrings; ++i)
+		bValid = ReadString(Snapshot, Offset, StringTable.AddDefaulted_GetRef());
+
+	for(int32 i = 0; bValid && i < OutValues.Strings.Num(); ++i)
+	{
+		uint32 Index = 0;
+		bValid = ReadVarint(Snapshot, Offset, Index) && Index < NumStrings;
+		if(bValid)
+			OutValues.Strings[i] = StringTable[Index];
+	}
+
+	if(!bValid)
+		UE_LOG(LogArticyRuntime, Error, TEXT("Unable to read GV snapshot: the data is corrupt."));
+
+	return bValid;
+}
+
+bool UArticyGlobalVariables::RestoreSnapshot(const TArray<uint8>& Snapshot, bool bNotifyChanges)
+{
+	//the values are written directly, so there must not be any shadow state to restore them into
+	if(GetShadowLevel() != 0)
+	{
+		UE_LOG(LogArticyRuntime, Error, TEXT("Cannot restore a GV snapshot while in a shadow state!"));
+		return false;
+	}
+
+	//decode everything before writing, so an invalid snapshot does not leave the variables half restored
+	FDecodedSnapshot Values;
+	if(!DecodeSnapshot(Snapshot, Values))
+		return false;
+
+	//write the values, the changes are notified at once at the end
+	FArticyGvChangeBatch ChangeBatch(bNotifyChanges ? this : nullptr);
+	int32 NextBool = 0, NextInt = 0, NextString = 0;
+	for(int32 Id = 0; Id < GetNumVariables(); ++Id)
+	{
+		bool bChanged = false;
+		switch(GetVariableType(Id))
+		{
+		case EArticyGvType::Bool:
+			bChanged = PokeValue<UArticyBool>(Id, Values.Bools[NextBool++]);
+			break;
+		case EArticyGvType::Int:
+			bChanged = PokeValue<UArticyInt>(Id, Values.Ints[NextInt++]);
+			break;
+		case EArticyGvType::String:
+			bChanged = PokeValue<UArticyString>(Id, Values.Strings[NextString++]);
+			break;
+		}
+
+		if(bChanged && bNotifyChanges)
+			NotifyValueChanged(Id);
+	}
+
+	return true;
+}
+
+//---------------------------------------------------------------------------//
+
+void UArticyGlobalVariables::MarkDirty(const int32 Id)
+{
+	++ChangeCount;
+
+	if(DirtyVariables.Num() <= Id)
+		DirtyVariables.Add(false, GetNumVariables() - DirtyVariables.Num());
+
+	DirtyVariables[Id] = true;
+}
+
+void UArticyGlobalVariables::ClearDirtyVariables()
+{
+	DirtyVariables.Init(false, DirtyVariables.Num());
+}
+
+void UArticyGlobalVariables::WriteDeltaValue(TArray<uint8>& Buffer, const int32 Id) const
+{
+	switch(GetVariableType(Id))
+	{
+	case EArticyGvType::Bool:
+		Buffer.Add(PeekValue<UArticyBool>(Id) ? 1 : 0);
+		break;
+	case EArticyGvType::Int:
+		WriteVarint(Buffer, ZigZagEncode(PeekValue<UArticyInt>(Id)));
+		break;
+	case EArticyGvType::String:
+		WriteString(Buffer, PeekValue<UArticyString>(Id));
+		break;
+	}
+}
+
+TArray<uint8> UArticyGlobalVariables::CaptureDelta(bool bClearDirty)
+{
+	TArray<int32> Changed;
+	for(TConstSetBitIterator<> It(DirtyVariables); It; ++It)
+		Changed.Add(It.GetIndex());
+
+	TArray<uint8> Buffer;
+	WriteSnapshotHeader(Buffer, GvDeltaVersion, Changed.Num());
+
+	int32 PreviousId = -1;
+	for(const int32 Id : Changed)
+	{
+		WriteVarint(Buffer, Id - PreviousId);
+		WriteDeltaValue(Buffer, Id);
+		PreviousId = Id;
+	}
+
+	if(bClearDirty)
+		ClearDirtyVariables();
+
+	return Buffer;
+}
+
+TArray<uint8> UArticyGlobalVariables::CaptureDeltaFromSnapshot(const TArray<uint8>& BaseSnapshot) const
+{
+	TArray<uint8> Buffer;
+
+	FDecodedSnapshot Base;
+	if(!DecodeSnapshot(BaseSnapshot, Base))
+		return Buffer;
+
+	TArray<int32> Changed;
+	int32 NextBool = 0, NextInt = 0, NextString = 0;
+	for(int32 Id = 0; Id < GetNumVariables(); ++Id)
+	{
+		bool bChanged = false;
+		switch(GetVariableType(Id))
+		{
+		case EArticyGvType::Bool:
+			bChanged = !IsSameValue(PeekValue<UArticyBool>(Id), Base.Bools[NextBool++]);
+			break;
+		case EArticyGvType::Int:
+			bChanged = !IsSameValue(PeekValue<UArticyInt>(Id), Base.Ints[NextInt++]);
+			break;
+		case EArticyGvType::String:
+			bChanged = !IsSameValue(PeekValue<UArticyString>(Id), Base.Strings[NextString++]);
+			break;
+		}
+
+		if(bChanged)
+			Changed.Add(Id);
+	}
+
+	WriteSnapshotHeader(Buffer, GvDeltaVersion, Changed.Num());
+
+	int32 PreviousId = -1;
+	for(const int32 Id : Changed)
+	{
+		WriteVarint(Buffer, Id - PreviousId);
+		WriteDeltaValue(Buffer, Id);
+		PreviousId = Id;
+	}
+
+	return Buffer;
+}
+
+bool UArticyGlobalVariables::ApplyDelta(const TArray<uint8>& Delta, bool bNotifyChanges)
+{
+	//the values are written directly, so there must not be any shadow state to restore them into
+	if(GetShadowLevel() != 0)
+	{
+		UE_LOG(LogArticyRuntime, Error, TEXT("Cannot apply a GV delta while in a shadow state!"));
+		return false;
+	}
+
+	int32 Offset = 0;
+	uint32 NumChanged = 0;
+	if(!ReadSnapshotHeader(Delta, Offset, GvDeltaVersion, NumChanged))
+		return false;
+
+	//decode everything before writing, so an invalid delta does not leave the variables half applied
+	struct FDeltaEntry
+	{
+		int32 Id;
+		uint32 Value;
+		FString String;
+	};
+	TArray<FDeltaEntry> Entries;
+
+	bool bValid = NumChanged <= static_cast<uint32>(GetNumVariables());
+	int32 Id = -1;
+	for(uint32 i = 0; bValid && i < NumChanged; ++i)
+	{
+		uint32 Distance = 0;
+		bValid = ReadVarint(Delta, Offset, Distance) && Distance > 0 && Distance <= static_cast<uint32>(GetNumVariables() - 1 - Id);
+		if(!bValid)
+			break;
+
+		Id += Distance;
+		auto& Entry = Entries.AddDefaulted_GetRef();
+		Entry.Id = Id;
+		switch(GetVariableType(Id))
+		{
+		case EArticyGvType::Bool:
+			bValid = Offset < Delta.Num();
+			Entry.Value = bValid ? Delta[Offset++] : 0;
+			break;
+		case EArticyGvType::Int:
+			bValid = ReadVarint(Delta, Offset, Entry.Value);
+			break;
+		case EArticyGvType::String:
+			bValid = ReadString(Delta, Offset, Entry.String);
+			break;
+		}
+	}
+
+	if(!bValid)
+	{
+		UE_LOG(LogArticyRuntime, Error, TEXT("Unable to apply GV delta: the data is corrupt."));
+		return false;
+	}
+
+	//write the values, the changes are notified at once at the end
+	FArticyGvChangeBatch ChangeBatch(bNotifyChanges ? this : nullptr);
+	for(const auto& Entry : Entries)
+	{
+		bool bChanged = false;
+		switch(GetVariableType(Entry.Id))
+		{
+		case EArticyGvType::Bool:
+			bChanged = PokeValue<UArticyBool>(Entry.Id, Entry.Value != 0);
+			break;
+		case EArticyGvType::Int:
+			bChanged = PokeValue<UArticyInt>(Entry.Id, ZigZagDecode(Entry.Value));
+			break;
+		case EArticyGvType::String:
+			bChanged = PokeValue<UArticyString>(Entry.Id, Entry.String);
+			break;
+		}
+
+		if(bChanged && bNotifyChanges)
+			NotifyValueChanged(Entry.Id);
+	}
+
+	return true;
+}
+
+//---------------------------------------------------------------------------//
+
+void UArticyGlobalVariables::PublishReadView()
+{
+	check(IsInGameThread());
+
+	//values in shadow states are only temporary
+	if(GetShadowLevel() != 0)
+	{
+		UE_LOG(LogArticyRuntime, Error, TEXT("Cannot publish a GV read view while in a shadow state!"));
+		return;
+	}
+
+	const FArticyGvReadView* Latest = ReadViews.GetLatest();
+	if(Latest && PublishedChangeCount == ChangeCount)
+		return;
+
+	auto View = MakeUnique<FArticyGvReadView>();
+	View->Version = Latest ? Latest->Version + 1 : 0;
+
+	const bool bNewLayout = !ReadViewLayout.IsValid();
+	TSharedPtr<FArticyGvReadViewLayout, ESPMode::ThreadSafe> NewLayout;
+	if(bNewLayout)
+		NewLayout = MakeShared<FArticyGvReadViewLayout, ESPMode::ThreadSafe>();
+
+	for(int32 Id = 0; Id < GetNumVariables(); ++Id)
+	{
+		const EArticyGvType Type = GetVariableType(Id);
+		int32 Index = INDEX_NONE;
+		switch(Type)
+		{
+		case EArticyGvType::Bool:
+			Index = View->Bools.Add(PeekValue<UArticyBool>(Id));
+			break;
+		case EArticyGvType::Int:
+			Index = View->Ints.Add(PeekValue<UArticyInt>(Id));
+			break;
+		case EArticyGvType::String:
+			Index = View->Strings.Add(PeekValue<UArticyString>(Id));
+			break;
+		}
+
+		if(bNewLayout)
+		{
+			NewLayout->Types.Add(Type);
+			NewLayout->Indices.Add(Index);
+			NewLayout->Ids.Add(UsesFlatStorage() ? FlatStorage.GetSlot(Id).Name : VariablesById[Id]->GetGVName(), Id);
+		}
+	}
+
+	if(bNewLayout)
+		ReadViewLayout = NewLayout;
+	View->Layout = ReadViewLayout;
+
+	ReadViews.Publish(MoveTemp(View));
+	PublishedChangeCount = ChangeCount;
+}
+
+void UArticyGlobalVariables::BeginDestroy()
+{
+	ReadViews.Reset();
+
+	Super::BeginDestroy();
+}
+
 void UArticyGlobalVariables::EnableDebugLogging()
 {
 	bLogVariableAccess = true;
@@ -344,6 +1104,62 @@ void UArticyGlobalVariables::DisableDebugLogging()
 	bLogVariableAccess = false;
 }
 
+UArticyVariable* UArticyGlobalVariables::GetVariableHandle(const int32 Slot)
+{
+	if(FlatHandles.Num() < FlatStorage.Num())
+		FlatHandles.SetNumZeroed(FlatStorage.Num());
+
+	auto& Handle = FlatHandles[Slot];
+	if(!Handle)
+	{
+		const auto& FlatSlot = FlatStorage.GetSlot(Slot);
+
+		UClass* HandleClass = nullptr;
+		switch(FlatSlot.Type)
+		{
+		case EArticyGvType::Bool:
+			HandleClass = UArticyBool::StaticClass();
+			break;
+		case EArticyGvType::Int:
+			HandleClass = UArticyInt::StaticClass();
+			break;
+		case EArticyGvType::String:
+			HandleClass = UArticyString::StaticClass();
+			break;
+		}
+
+		Handle = NewObject<UArticyVariable>(this, HandleClass, NAME_None, RF_Transient);
+		Handle->InitFlat(FlatSlot.Set, this, FlatSlot.Name, Slot);
+	}
+
+	return Handle;
+}
+
+void UArticyGlobalVariables::BroadcastFlatValueChanged(const int32 Slot)
+{
+	UArticyVariable* Handle = FlatHandles.IsValidIndex(Slot) ? FlatHandles[Slot] : nullptr;
+	if(!Handle)
+	{
+		//without a handle, only the namespace can have listeners
+		const auto Set = FlatStorage.GetSlot(Slot).Set;
+		if(!Set || !Set->OnVariableChanged.IsBound())
+			return;
+
+		Handle = GetVariableHandle(Slot);
+	}
+
+	Handle->OnVariableChanged.Broadcast(Handle);
+}
+
+void UArticyGlobalVariables::Serialize(FArchive& Ar)
+{
+	Super::Serialize(Ar);
+
+	//the layout of the flat storage is created by the generated constructor, only clones copy the current values
+	if(UsesFlatStorage() && Ar.HasAnyPortFlags(PPF_Duplicate))
+		FlatStorage.SerializeValues(Ar);
+}
+
 TWeakObjectPtr<UArticyGlobalVariables> UArticyGlobalVariables::Clone;
 TMap<FName, TWeakObjectPtr< UArticyGlobalVariables>> UArticyGlobalVariables::OtherClones;
 
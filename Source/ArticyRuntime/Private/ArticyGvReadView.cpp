@@ -0,0 +1,98 @@
+//  
+// Copyright (c) 2023 articy Software GmbH & Co. KG. All rights reserved.  
+//
+
+#include "ArticyGvReadView.h"
+
+int32 FArticyGvReadView::FindId(const FName& FullName) const
+{
+	const int32* Id = Layout ? Layout->Ids.Find(FullName) : nullptr;
+	return Id ? *Id : INDEX_NONE;
+}
+
+bool FArticyGvReadView::GetBool(const int32 Id, bool& OutValue) const
+{
+	return GetValue(Id, EArticyGvType::Bool, Bools, OutValue);
+}
+
+bool FArticyGvReadView::GetInt(const int32 Id, int32& OutValue) const
+{
+	return GetValue(Id, EArticyGvType::Int, Ints, OutValue);
+}
+
+bool FArticyGvReadView::GetString(const int32 Id, FString& OutValue) const
+{
+	return GetValue(Id, EArticyGvType::String, Strings, OutValue);
+}
+
+template<typename T>
+bool FArticyGvReadView::GetValue(const int32 Id, const EArticyGvType Type, const TArray<T>& Values, T& OutValue) const
+{
+	if(!Layout || !Layout->Types.IsValidIndex(Id) || Layout->Types[Id] != Type)
+		return false;
+
+	OutValue = Values[Layout->Indices[Id]];
+	return true;
+}
+
+//---------------------------------------------------------------------------//
+
+FArticyGvReadViews::~FArticyGvReadViews()
+{
+	Reset();
+}
+
+void FArticyGvReadViews::Publish(TUniquePtr<FArticyGvReadView> View)
+{
+	const uint64 CurrentEpoch = Epoch.load();
+	if(const FArticyGvReadView* Replaced = Latest.exchange(View.Release()))
+		Retired[CurrentEpoch & 1].Add(Replaced);
+
+	//readers of the previous epoch might still use the views retired back then, which share the parity of the next epoch.
+	//once they are gone, the next epoch can start, as new readers cannot get hold of those views anymore
+	const int32 NextParity = (CurrentEpoch + 1) & 1;
+	if(Readers[NextParity].load() == 0)
+	{
+		DeleteRetired(NextParity);
+		Epoch.store(CurrentEpoch + 1);
+	}
+}
+
+void FArticyGvReadViews::Reset()
+{
+	const FArticyGvReadView* Replaced = Latest.exchange(nullptr);
+
+	while(Readers[0].load() > 0 || Readers[1].load() > 0)
+		FPlatformProcess::Yield();
+
+	delete Replaced;
+	DeleteRetired(0);
+	DeleteRetired(1);
+}
+
+void FArticyGvReadViews::DeleteRetired(const int32 Parity)
+{
+	for(const FArticyGvReadView* View : Retired[Parity])
+		delete View;
+	Retired[Parity].Reset();
+}
+
+FArticyGvReadViews::FReadScope::FReadScope(const FArticyGvReadViews& InViews) : Views(InViews)
+{
+	//register in the current epoch, retry if it changed in the meantime
+	while(true)
+	{
+		Epoch = Views.Epoch.load();
+		Views.Readers[Epoch & 1].fetch_add(1);
+		if(Views.Epoch.load() == Epoch)
+			break;
+		Views.Readers[Epoch & 1].fetch_sub(1);
+	}
+
+	View = Views.Latest.load();
+}
+
+FArticyGvReadViews::FReadScope::~FReadScope()
+{
+	Views.Readers[Epoch & 1].fetch_sub(1);
+}
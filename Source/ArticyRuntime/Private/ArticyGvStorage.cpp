@@ -0,0 +1,72 @@
+//  
+// Copyright (c) 2023 articy Software GmbH & Co. KG. All rights reserved.  
+//
+
+#include "ArticyGvStorage.h"
+
+int32 FArticyGvStorage::AddVariable(UArticyBaseVariableSet* Set, const FName& Name, const bool& InitialValue)
+{
+	return Add(Set, Name, EArticyGvType::Bool, InitialValue);
+}
+
+int32 FArticyGvStorage::AddVariable(UArticyBaseVariableSet* Set, const FName& Name, const int32& InitialValue)
+{
+	return Add(Set, Name, EArticyGvType::Int, InitialValue);
+}
+
+int32 FArticyGvStorage::AddVariable(UArticyBaseVariableSet* Set, const FName& Name, const FString& InitialValue)
+{
+	return Add(Set, Name, EArticyGvType::String, InitialValue);
+}
+
+template<typename T>
+int32 FArticyGvStorage::Add(UArticyBaseVariableSet* Set, const FName& Name, const EArticyGvType Type, const T& InitialValue)
+{
+	auto& TypedValues = Values(static_cast<T*>(nullptr));
+
+	FArticyGvSlot NewSlot;
+	NewSlot.Name = Name;
+	NewSlot.Type = Type;
+	NewSlot.Index = TypedValues.Add(InitialValue);
+	NewSlot.Set = Set;
+
+	const int32 Slot = Slots.Add(NewSlot);
+	ensureMsgf(!SlotsByName.Contains(Name), TEXT("Global variable %s was added twice!"), *Name.ToString());
+	SlotsByName.Add(Name, Slot);
+
+	return Slot;
+}
+
+int32 FArticyGvStorage::FindSlot(const FName& FullName) const
+{
+	const int32* Slot = SlotsByName.Find(FullName);
+	return Slot ? *Slot : INDEX_NONE;
+}
+
+void FArticyGvStorage::PopShadowLevel()
+{
+	if(!ensure(UndoLogStarts.Num() > 0))
+		return;
+
+	const auto Start = UndoLogStarts.Pop();
+	Rollback(Bools, BoolUndoLog, Start.Bools);
+	Rollback(Ints, IntUndoLog, Start.Ints);
+	Rollback(Strings, StringUndoLog, Start.Strings);
+}
+
+template<typename T>
+void FArticyGvStorage::Rollback(TArray<T>& Values, TArray<TUndoEntry<T>>& UndoLog, const int32 Start)
+{
+	//restore in reverse order, so the oldest value of each variable is restored last
+	for(int32 i = UndoLog.Num() - 1; i >= Start; --i)
+		Values[UndoLog[i].Index] = MoveTemp(UndoLog[i].OldValue);
+
+	UndoLog.SetNum(Start, false);
+}
+
+void FArticyGvStorage::SerializeValues(FArchive& Ar)
+{
+	Ar << Bools;
+	Ar << Ints;
+	Ar << Strings;
+}
@@ -16,6 +16,7 @@ void UArticyFlowPin::InitFromJson(TSharedPtr<FJsonValue> Json)
 
 	auto obj = Json->AsObject();
 	JSON_TRY_FNAME(obj, Text);
+	ScriptHash = GetTypeHash(Text);
 
 	auto id = obj->TryGetField(TEXT("Owner"));
 	Owner = FArticyId{id};
@@ -39,18 +40,29 @@ UArticyObject* UArticyFlowPin::GetOwner()
 	return ensure(db) ? db->GetObject<UArticyObject>(Owner) : nullptr;
 }
 
+int32 UArticyFlowPin::GetScriptHash() const
+{
+	//pins imported before the hash was stored have to hash their text
+	return ScriptHash != 0 || !HasScript() ? ScriptHash : GetTypeHash(Text);
+}
+
 //---------------------------------------------------------------------------//
 
 bool UArticyInputPin::Evaluate(class UArticyGlobalVariables* GV, class UObject* MethodProvider)
 {
+	//empty conditions are always true
+	if(!HasScript())
+		return true;
+
 	auto db = UArticyDatabase::Get(this);
-	return db->GetExpressoInstance()->Evaluate(GetTypeHash(Text), GV ? GV : db->GetGVs(), MethodProvider);
+	return db->GetExpressoInstance()->Evaluate(ScriptIndex, GetScriptHash(), GV ? GV : db->GetGVs(), MethodProvider);
 }
 
 void UArticyInputPin::Explore(UArticyFlowPlayer* Player, TArray<FArticyBranch>& OutBranches, const uint32& Depth)
 {
 	//evaluate first, as the evaluate method could have side-effects
 	bool bIsValid = Evaluate(Player->GetGVs(), Player->GetMethodsProvider());
+	const int32 FirstBranch = OutBranches.Num();
 
 	//we can stop here if the branch is invalid and should be ignored
 	if(!bIsValid && Player->IgnoresInvalidBranches())
@@ -61,7 +73,7 @@ void UArticyInputPin::Explore(UArticyFlowPlayer* Player, TArray<FArticyBranch>&
 	if(Depth > 3 && Player->ShouldPauseOn(owner))
 	{
 		// if the owner of this input pin is a stop node, we directly continue with it instead of submerging
-		OutBranches.Append(Player->Explore(owner, false, Depth + 1));
+		Player->Explore(owner, false, Depth + 1, OutBranches);
 	}
 	else if(Connections.Num() > 0)
 	{
@@ -72,13 +84,13 @@ void UArticyInputPin::Explore(UArticyFlowPlayer* Player, TArray<FArticyBranch>&
 		for(auto conn : Connections)
 		{
 			auto target = conn->GetTargetPin();
-			OutBranches.Append( Player->Explore(target, bShadowed, Depth + 1) );
+			Player->Explore(target, bShadowed, Depth + 1, OutBranches);
 		}
 	}
 	else
 	{
 		//no connections, so continue with the owner itself
-		OutBranches.Append( Player->Explore(owner, false, Depth+1) );
+		Player->Explore(owner, false, Depth+1, OutBranches);
 	}
 
 	/**
@@ -88,8 +100,8 @@ void UArticyInputPin::Explore(UArticyFlowPlayer* Player, TArray<FArticyBranch>&
 	 */
 	if(!bIsValid)
 	{
-		for(auto& branch : OutBranches)
-			branch.bIsValid = false;
+		for(int32 i = FirstBranch; i < OutBranches.Num(); ++i)
+			OutBranches[i].bIsValid = false;
 	}
 }
 
@@ -97,8 +109,11 @@ void UArticyInputPin::Explore(UArticyFlowPlayer* Player, TArray<FArticyBranch>&
 
 void UArticyOutputPin::Execute(class UArticyGlobalVariables* GV, class UObject* MethodProvider)
 {
+	if(!HasScript())
+		return;
+
 	auto db = UArticyDatabase::Get(this);
-	db->GetExpressoInstance()->Execute(GetTypeHash(Text), GV ? GV : db->GetGVs(), MethodProvider);
+	db->GetExpressoInstance()->Execute(ScriptIndex, GetScriptHash(), GV ? GV : db->GetGVs(), MethodProvider);
 }
 
 void UArticyOutputPin::Explore(UArticyFlowPlayer* Player, TArray<FArticyBranch>& OutBranches, const uint32& Depth)
@@ -114,7 +129,7 @@ void UArticyOutputPin::Explore(UArticyFlowPlayer* Player, TArray<FArticyBranch>&
 		for(auto conn : Connections)
 		{
 			auto target = conn->GetTargetPin();
-			OutBranches.Append( Player->Explore(target, bShadowed, Depth+1) );
+			Player->Explore(target, bShadowed, Depth+1, OutBranches);
 		}
 	}
 	else
@@ -17,11 +17,16 @@ UArticyPluginSettings::UArticyPluginSettings()
 	bCreateBlueprintTypeForScriptMethods = true;
 	bKeepDatabaseBetweenWorlds = true;
 	bKeepGlobalVariablesBetweenWorlds = true;
+	bUseCopyOnWriteObjects = false;
+	bUseUndoLogForShadowStates = false;
+	AsyncLoadBudgetMs = 2.f;
 	bConvertUnityToUnrealRichText = false;
 	bVerifyArticyReferenceBeforeImport = true;
 	bUseLegacyImporter = false;
 	
 	bSortChildrenAtGeneration = false;
+	ExpressoScriptsShardCount = 0;
+	bUseFlatGlobalVariableStorage = false;
 	ArticyDirectory.Path = TEXT("/Game");
 	// update package load settings after all files have been loaded
 	FAssetRegistryModule& AssetRegistry = FModuleManager::Get().GetModuleChecked<FAssetRegistryModule>("AssetRegistry");
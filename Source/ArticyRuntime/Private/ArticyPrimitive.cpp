@@ -0,0 +1,39 @@
+//  
+// Copyright (c) 2023 articy Software GmbH & Co. KG. All rights reserved.  
+//
+
+#include "ArticyPrimitive.h"
+#include "ArticyDatabase.h"
+#include "ArticyRuntimeModule.h"
+
+IArticyReflectable* UArticyPrimitive::PrepareForWrite()
+{
+	if(!bSharedAsset)
+		return this;
+
+	if(CopyOnWriteOwner.IsValid())
+	{
+		auto Copy = CopyOnWriteOwner->Materialize();
+		if(Copy && Copy != this)
+			return Copy;
+	}
+
+	UE_LOG(LogArticyRuntime, Error, TEXT("Cannot write to %s, it is a package asset which is no longer loaded by a database."), *GetName());
+	return nullptr;
+}
+
+const IArticyReflectable* UArticyPrimitive::GetReadTarget() const
+{
+	//this is on the path of every property read, objects which are not shared return right away
+	if(!bSharedAsset)
+		return this;
+
+	if(CopyOnWriteOwner.IsValid())
+	{
+		auto Current = CopyOnWriteOwner->Get(nullptr, 0, /*bForceUnshadowed = */ true);
+		if(Current && Current != this)
+			return Current;
+	}
+
+	return this;
+}
@@ -31,7 +31,7 @@ void UArticyScriptFragment::InitFromJson(TSharedPtr<FJsonValue> Json)
 bool UArticyScriptCondition::Evaluate(class UArticyGlobalVariables* GV, class UObject* MethodProvider)
 {
 	auto db = UArticyDatabase::Get(this);
-	return db->GetExpressoInstance()->Evaluate(GetExpressionHash(), GV ? GV : db->GetGVs(), MethodProvider);
+	return db->GetExpressoInstance()->Evaluate(FragmentIndex, GetExpressionHash(), GV ? GV : db->GetGVs(), MethodProvider);
 }
 
 bool UArticyCondition::Evaluate(UArticyGlobalVariables* GV, UObject* MethodProvider)
@@ -51,9 +51,9 @@ void UArticyCondition::Explore(UArticyFlowPlayer* Player, TArray<FArticyBranch>&
 	}
 
 	if(Evaluate(Player->GetGVs(), Player->GetMethodsProvider()))
-		OutBranches.Append( Player->Explore((*pins)[0], false, Depth+1) ); //TRUE
+		Player->Explore((*pins)[0], false, Depth+1, OutBranches); //TRUE
 	else
-		OutBranches.Append( Player->Explore((*pins)[1], false, Depth+1) ); //FALSE
+		Player->Explore((*pins)[1], false, Depth+1, OutBranches); //FALSE
 }
 
 //---------------------------------------------------------------------------//
@@ -61,7 +61,7 @@ void UArticyCondition::Explore(UArticyFlowPlayer* Player, TArray<FArticyBranch>&
 void UArticyScriptInstruction::Execute(class UArticyGlobalVariables* GV, class UObject* MethodProvider)
 {
 	auto db = UArticyDatabase::Get(this);
-	db->GetExpressoInstance()->Execute(GetExpressionHash(), GV ? GV : db->GetGVs(), MethodProvider);
+	db->GetExpressoInstance()->Execute(FragmentIndex, GetExpressionHash(), GV ? GV : db->GetGVs(), MethodProvider);
 }
 
 UArticyScriptCondition* UArticyCondition::GetCondition() const
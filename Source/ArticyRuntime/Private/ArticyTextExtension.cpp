@@ -199,8 +199,8 @@ void UArticyTextExtension::GetGlobalVariable(UObject* Outer, const FString& Sour
 		return;
 	}
 	
-	UArticyVariable** Variable = Set->GetPropPtr<UArticyVariable*>(GvName.GetVariable());
-	switch (GetObjectType(Variable))
+	UArticyVariable* Variable = Set->FindVariable(GvName.GetVariable());
+	switch (GetObjectType(&Variable))
 	{
 	case EArticyObjectType::UArticyBool:
 		{
@@ -267,7 +267,7 @@ void UArticyTextExtension::GetObjectProperty(UObject* Outer, const FString& Sour
 
 	if (bRequestType)
 	{
-		OutString = Object->ArticyType.GetProperty(PropertyName).PropertyType;
+		OutString = Object->GetArticyTypeRef().GetProperty(PropertyName).PropertyType;
 		OutSuccess = true;
 		return;
 	}
@@ -310,7 +310,13 @@ void UArticyTextExtension::GetTypeProperty(const FString& TypeName, const FStrin
 	bool& OutSuccess)
 {
 	UArticyTypeSystem* TypeSystem = UArticyTypeSystem::Get();
-	FArticyType TypeData = TypeSystem->GetArticyType(TypeName);
+	if (!TypeSystem)
+	{
+		OutSuccess = false;
+		return;
+	}
+
+	const FArticyType& TypeData = TypeSystem->GetArticyType(TypeName);
 	FArticyPropertyInfo PropertyInfo{};
 	bool bFoundProperty = false;
 	
@@ -4,9 +4,23 @@
 
 #include "ArticyType.h"
 #include "ArticyHelpers.h"
+#include "ArticyTypeSystem.h"
 
-FArticyEnumValueInfo FArticyType::GetEnumValue(int Value) const
+namespace
 {
+	const FArticyEnumValueInfo EmptyEnumValue{};
+	const FArticyPropertyInfo EmptyProperty{};
+	const TArray<FArticyPropertyInfo> EmptyProperties;
+}
+
+const FArticyEnumValueInfo& FArticyType::GetEnumValue(int Value) const
+{
+	if (bHasIndices)
+	{
+		const int32* Index = EnumValueIndices.Find(Value);
+		return Index ? EnumValues[*Index] : EmptyEnumValue;
+	}
+
 	for (const auto& EnumInfo : EnumValues)
 	{
 		if (EnumInfo.Value == Value)
@@ -14,11 +28,22 @@ FArticyEnumValueInfo FArticyType::GetEnumValue(int Value) const
 			return EnumInfo;
 		}
 	}
-	return {};
+	return EmptyEnumValue;
 }
 
-FArticyEnumValueInfo FArticyType::GetEnumValue(const FString& ValueName) const
+const FArticyEnumValueInfo& FArticyType::GetEnumValue(const FString& ValueName) const
 {
+	if (bHasIndices)
+	{
+		//names only differing in case share an index entry, so the exact match might need a search
+		const FName Key(*ValueName, FNAME_Find);
+		const int32* Index = Key.IsNone() ? nullptr : EnumNameIndices.Find(Key);
+		if (!Index)
+			return EmptyEnumValue;
+		if (EnumValues[*Index].LocaKey_DisplayName.Equals(ValueName))
+			return EnumValues[*Index];
+	}
+
 	for (const auto& EnumInfo : EnumValues)
 	{
 		if (EnumInfo.LocaKey_DisplayName.Equals(ValueName))
@@ -26,7 +51,7 @@ FArticyEnumValueInfo FArticyType::GetEnumValue(const FString& ValueName) const
 			return EnumInfo;
 		}
 	}
-	return {};
+	return EmptyEnumValue;
 }
 
 FString FArticyType::GetFeatureDisplayName(UObject* Outer, const FString& FeatureName) const
@@ -39,19 +64,35 @@ FString FArticyType::GetFeatureDisplayNameLocaKey(const FString& FeatureName) co
 	return FeatureName;
 }
 
-TArray<FArticyPropertyInfo> FArticyType::GetProperties() const
+const TArray<FArticyPropertyInfo>& FArticyType::GetProperties() const
 {
 	return Properties;
 }
 
-TArray<FArticyPropertyInfo> FArticyType::GetPropertiesInFeature(const FString& FeatureName) const
+const TArray<FArticyPropertyInfo>& FArticyType::GetPropertiesInFeature(const FString& FeatureName) const
 {
-	// TODO: Implement this functionality
-	return {};
+	const UArticyTypeSystem* System = TypeSystem.Get();
+	const FArticyType* FeatureType = System ? System->FindFeatureType(FeatureName) : nullptr;
+	if (!FeatureType)
+		return EmptyProperties;
+
+	//Features holds display names, only features of this type are returned
+	const bool bHasFeature = Features.Contains(FeatureName) || Features.Contains(FeatureType->LocaKey_DisplayName) || Features.Contains(FeatureType->TechnicalName);
+	return bHasFeature ? FeatureType->Properties : EmptyProperties;
 }
 
-FArticyPropertyInfo FArticyType::GetProperty(const FString& PropertyName) const
+const FArticyPropertyInfo& FArticyType::GetProperty(const FString& PropertyName) const
 {
+	if (bHasIndices)
+	{
+		const FName Key(*PropertyName, FNAME_Find);
+		const int32* Index = Key.IsNone() ? nullptr : PropertyIndices.Find(Key);
+		if (!Index)
+			return EmptyProperty;
+		if (Properties[*Index].LocaKey_DisplayName.Equals(PropertyName))
+			return Properties[*Index];
+	}
+
 	for (const auto& PropertyInfo : Properties)
 	{
 		if (PropertyInfo.LocaKey_DisplayName.Equals(PropertyName))
@@ -59,7 +100,27 @@ FArticyPropertyInfo FArticyType::GetProperty(const FString& PropertyName) const
 			return PropertyInfo;
 		}
 	}
-	return {};
+	return EmptyProperty;
+}
+
+void FArticyType::BuildIndices(const UArticyTypeSystem* InTypeSystem)
+{
+	PropertyIndices.Reset();
+	EnumValueIndices.Reset();
+	EnumNameIndices.Reset();
+	TypeSystem = InTypeSystem;
+
+	//the first entry wins, like in a linear search
+	for (int32 i = 0; i < Properties.Num(); ++i)
+		PropertyIndices.FindOrAdd(FName(*Properties[i].LocaKey_DisplayName), i);
+
+	for (int32 i = 0; i < EnumValues.Num(); ++i)
+	{
+		EnumValueIndices.FindOrAdd(EnumValues[i].Value, i);
+		EnumNameIndices.FindOrAdd(FName(*EnumValues[i].LocaKey_DisplayName), i);
+	}
+
+	bHasIndices = true;
 }
 
 FString FArticyType::GetDisplayName(UObject* Outer)
@@ -6,25 +6,124 @@
 
 #include "ArticyDatabase.h"
 #include "ArticyType.h"
+#include "ArticyRuntimeModule.h"
+#include "Misc/ScopeRWLock.h"
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >0 
+#include "AssetRegistry/AssetRegistryModule.h"
+#else
+#include "AssetRegistryModule.h"
+#endif
 
 UArticyTypeSystem* UArticyTypeSystem::Get()
 {
-	static TWeakObjectPtr<UArticyTypeSystem> ArticyTypeSystem;
+	//the type system is rooted, the types are handed out by reference and must stay alive
+	static UArticyTypeSystem* ArticyTypeSystem = nullptr;
 
-	if (!ArticyTypeSystem.IsValid())
+	if (!ArticyTypeSystem)
 	{
-		ArticyTypeSystem = TWeakObjectPtr<UArticyTypeSystem>(NewObject<UArticyTypeSystem>());
+		//loading is only possible on the game thread, UArticyDatabase::Get loads it before any lookups
+		if (!IsInGameThread())
+		{
+			UE_LOG(LogArticyRuntime, Error, TEXT("The ArticyTypeSystem must be loaded on the game thread before it is used on other threads."));
+			return nullptr;
+		}
+
+		//the types are stored in the generated type system asset
+		FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+		TArray<FAssetData> AssetData;
+
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >0
+		AssetRegistryModule.Get().GetAssetsByClass(StaticClass()->GetClassPathName(), AssetData, true);
+#else
+		AssetRegistryModule.Get().GetAssetsByClass(StaticClass()->GetFName(), AssetData, true);
+#endif
+
+		if (AssetData.Num() != 0)
+			ArticyTypeSystem = Cast<UArticyTypeSystem>(AssetData[0].GetAsset());
+
+		if (!ArticyTypeSystem)
+		{
+			UE_LOG(LogArticyRuntime, Warning, TEXT("No ArticyTypeSystem asset was found, type information is not available."));
+			ArticyTypeSystem = NewObject<UArticyTypeSystem>();
+		}
+
+		ArticyTypeSystem->AddToRoot();
 	}
 
-	return ArticyTypeSystem.Get();
+	return ArticyTypeSystem;
+}
+
+const FArticyType& UArticyTypeSystem::GetArticyType(const FString& TypeName) const
+{
+	static const FArticyType Empty;
+	const FArticyType* Type = Types.Find(TypeName);
+	return Type ? *Type : Empty;
+}
+
+const FArticyType* UArticyTypeSystem::FindFeatureType(const FString& FeatureName) const
+{
+	if (const FArticyType* FeatureType = FeatureTypes.Find(FeatureName))
+		return FeatureType;
+
+	const FString* TechnicalName = FeatureTechnicalNames.Find(FeatureName);
+	return TechnicalName ? FeatureTypes.Find(*TechnicalName) : nullptr;
+}
+
+void UArticyTypeSystem::BuildIndices()
+{
+	FeatureTechnicalNames.Reset();
+	for (const auto& Feature : FeatureTypes)
+		FeatureTechnicalNames.Add(Feature.Value.LocaKey_DisplayName, Feature.Key);
+
+	for (auto& Feature : FeatureTypes)
+		Feature.Value.BuildIndices(this);
+	for (auto& Type : Types)
+		Type.Value.BuildIndices(this);
+
+	FWriteScopeLock WriteLock(TypesByClassLock);
+	TypesByClass.Reset();
 }
 
-FArticyType UArticyTypeSystem::GetArticyType(const FString& TypeName) const
+void UArticyTypeSystem::PostLoad()
 {
-	if (Types.Contains(TypeName))
+	Super::PostLoad();
+
+	//type system assets generated by older versions did not store the types
+	if (Types.Num() == 0 && !HasAnyFlags(RF_ClassDefaultObject))
+		UE_LOG(LogArticyRuntime, Warning, TEXT("The ArticyTypeSystem asset %s contains no types, reimport the articy data to generate them."), *GetName());
+
+	BuildIndices();
+}
+
+const FArticyType& UArticyTypeSystem::GetArticyTypeOfClass(const UClass* Class) const
+{
+	{
+		FReadScopeLock ReadLock(TypesByClassLock);
+		if (const FArticyType* const* Cached = TypesByClass.Find(Class))
+			return **Cached;
+	}
+
+	static const FArticyType Empty;
+	const FArticyType* Type = &Empty;
+
+	for (const UClass* TypeClass = Class; TypeClass && Type == &Empty; TypeClass = TypeClass->GetSuperClass())
 	{
-		return Types[TypeName];
+		const FString CppType = FString(TypeClass->GetPrefixCPP()) + TypeClass->GetName();
+		for (const auto* TypeMap : { &Types, &FeatureTypes })
+		{
+			for (const auto& Pair : *TypeMap)
+			{
+				if (Pair.Value.CPPType == CppType)
+				{
+					Type = &Pair.Value;
+					break;
+				}
+			}
+		}
 	}
 
-	return {};
+	//another thread might have found the same type in the meantime, which does no harm
+	FWriteScopeLock WriteLock(TypesByClassLock);
+	TypesByClass.Add(Class, Type);
+	return *Type;
 }
@@ -32,7 +32,7 @@ bool IArticyInputPinsProvider::TrySubmerge(class UArticyFlowPlayer* Player, TArr
 			if(ensure(pin) && pin->Connections.Num() > 0)
 			{
 				bSubmerged = true;
-				OutBranches.Append( Player->Explore(pin, bShadowed, Depth+1) );
+				Player->Explore(pin, bShadowed, Depth+1, OutBranches);
 			}
 		}
 	}
@@ -13,7 +13,7 @@ void IArticyOutputPinsProvider::Explore(UArticyFlowPlayer* Player, TArray<FArtic
 		const auto bShadowed = pins->Num() > 1;
 
 		for(auto pin : *pins)
-			OutBranches.Append( Player->Explore(pin, bShadowed, Depth + 1) );
+			Player->Explore(pin, bShadowed, Depth + 1, OutBranches);
 	}
 	else
 	{
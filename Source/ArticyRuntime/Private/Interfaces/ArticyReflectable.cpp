@@ -0,0 +1,31 @@
+//  
+// Copyright (c) 2023 articy Software GmbH & Co. KG. All rights reserved.  
+//
+
+#include "Interfaces/ArticyReflectable.h"
+#include "Misc/ScopeRWLock.h"
+
+const FArticyPropertyTable& FArticyPropertyTable::Get(const UClass* Class)
+{
+	//the tables are allocated separately, so references to them stay valid when the map grows
+	static TMap<const UClass*, TUniquePtr<FArticyPropertyTable>> Tables;
+	static FRWLock TablesLock;
+
+	{
+		FReadScopeLock ReadLock(TablesLock);
+		if (auto table = Tables.Find(Class))
+			return **table;
+	}
+
+	FWriteScopeLock WriteLock(TablesLock);
+	auto& table = Tables.FindOrAdd(Class);
+	if (!table)
+	{
+		//property pointers can only be found by iterating over them, using the TFieldIterator
+		table = MakeUnique<FArticyPropertyTable>();
+		for (TFieldIterator<FProperty> It(Class); It; ++It)
+			table->Properties.Add(*It->GetNameCPP(), *It);
+	}
+
+	return *table;
+}
@@ -4,16 +4,74 @@
 
 
 #include "ShadowStateManager.h"
+#include "UObject/UnrealType.h"
 
 void IShadowStateManager::UnregisterOnPopState(FDelegateHandle Delegate)
 {
 	OnPopStateDelegates.Last().Remove(Delegate);
 }
 
+void IShadowStateManager::AddToUndoLog(void* Target, void (*Undo)(void* Target))
+{
+	if(ensureMsgf(UndoLogStarts.Num() > 0, TEXT("Cannot add to the undo log without a shadow state!")))
+	{
+		auto& Entry = UndoLog.AddDefaulted_GetRef();
+		Entry.Target = Target;
+		Entry.Undo = Undo;
+	}
+}
+
+void IShadowStateManager::AddToUndoLog(UObject* Object, int32 Index, void (*Undo)(UObject* Object, int32 Index))
+{
+	if(ensureMsgf(UndoLogStarts.Num() > 0, TEXT("Cannot add to the undo log without a shadow state!")))
+	{
+		auto& Entry = UndoLog.AddDefaulted_GetRef();
+		Entry.Object = Object;
+		Entry.Index = Index;
+		Entry.UndoObject = Undo;
+	}
+}
+
+void IShadowStateManager::RecordPropertyChange(UObject* Object, FProperty* Property)
+{
+	if(!Object || !Property)
+		return;
+
+	//objects are owned by the database (directly, or via the object they belong to)
+	for(UObject* Outer = Object->GetOuter(); Outer; Outer = Outer->GetOuter())
+	{
+		if(IShadowStateManager* Manager = Cast<IShadowStateManager>(Outer))
+		{
+			if(Manager->ShadowLevel == 0)
+				++Manager->PropertyChangeCount;
+			else if(Manager->UsesPropertyUndoLog())
+				Manager->AddPropertyToUndoLog(Object, Property);
+			return;
+		}
+	}
+}
+
+void IShadowStateManager::AddPropertyToUndoLog(UObject* Object, FProperty* Property)
+{
+	if(!ensureMsgf(UndoLogStarts.Num() > 0, TEXT("Cannot add to the undo log without a shadow state!")))
+		return;
+
+	//copy the complete current value into the value buffer
+	const int32 ValueOffset = Align(PropertyUndoValues.Num(), FMath::Max(Property->GetMinAlignment(), 1));
+	PropertyUndoValues.SetNumUninitialized(ValueOffset + Property->GetSize(), false);
+
+	void* OldValue = PropertyUndoValues.GetData() + ValueOffset;
+	Property->InitializeValue(OldValue);
+	Property->CopyCompleteValue(OldValue, Property->ContainerPtrToValuePtr<void>(Object));
+
+	PropertyUndoLog.Add({ Object, Property, ValueOffset });
+}
+
 void IShadowStateManager::PushState(uint32 NewShadowLevel)
 {
 	//create a new delegate just for this new shadow state
 	OnPopStateDelegates.Emplace();
+	UndoLogStarts.Add({ UndoLog.Num(), PropertyUndoLog.Num(), PropertyUndoValues.Num() });
 	++ShadowLevel;
 
 	ensureMsgf(ShadowLevel == NewShadowLevel, TEXT("ShadowLevels do not match in PushState!"));
@@ -23,6 +81,34 @@ void IShadowStateManager::PopState(uint32 CurrShadowLevel)
 {
 	ensureMsgf(ShadowLevel == CurrShadowLevel, TEXT("ShadowLevels do not match in PopState!"));
 
+	if(ensureMsgf(UndoLogStarts.Num() > 0, TEXT("UndoLogStarts empty while popping a state!")))
+	{
+		//undo everything that was logged during THIS operation, most recent first
+		const FUndoLogStart Start = UndoLogStarts.Pop();
+		for(int32 i = PropertyUndoLog.Num() - 1; i >= Start.PropertyUndoLog; --i)
+		{
+			const auto& Entry = PropertyUndoLog[i];
+			void* OldValue = PropertyUndoValues.GetData() + Entry.ValueOffset;
+			if(UObject* Object = Entry.Object.Get())
+				Entry.Property->CopyCompleteValue(Entry.Property->ContainerPtrToValuePtr<void>(Object), OldValue);
+
+			Entry.Property->DestroyValue(OldValue);
+		}
+
+		for(int32 i = UndoLog.Num() - 1; i >= Start.UndoLog; --i)
+		{
+			const auto& Entry = UndoLog[i];
+			if(!Entry.UndoObject)
+				Entry.Undo(Entry.Target);
+			else if(UObject* Object = Entry.Object.Get())
+				Entry.UndoObject(Object, Entry.Index);
+		}
+
+		PropertyUndoLog.SetNum(Start.PropertyUndoLog, false);
+		PropertyUndoValues.SetNum(Start.PropertyUndoValues, false);
+		UndoLog.SetNum(Start.UndoLog, false);
+	}
+
 	if(ensureMsgf(OnPopStateDelegates.Num() > 0, TEXT("InPopStateDelegates empty while popping a state!")))
 	{
 		//notify only the variables that registered during THIS operation
@@ -11,6 +11,8 @@
 #include "Engine/Texture2D.h"
 #include "ArticyAsset.generated.h"
 
+struct FStreamableHandle;
+
 UENUM(BlueprintType)
 enum class EArticyAssetCategory : uint8
 {
@@ -31,6 +33,11 @@ enum class EArticyAssetCategory : uint8
 	All = 0xFF,
 };
 
+DECLARE_DYNAMIC_DELEGATE_OneParam(FOnArticyAssetLoaded, UObject*, Asset);
+
+/** Callback for LoadAssetAsync, called on the game thread with the loaded asset (nullptr if it failed to load). */
+typedef TFunction<void(UObject* Asset)> FArticyAssetLoadedCallback;
+
 /**
  * Base class for all imported assets.
  */
@@ -54,6 +61,28 @@ public:
 
 	UFUNCTION(BlueprintCallable, Category = "Load Asset")
 	UFileMediaSource* LoadAsFileMediaSource() const;
+
+	/**
+	 * Loads the referenced asset without blocking, OnLoaded is called right away if it is loaded already.
+	 * The asset is kept in memory until OnLoaded was called, afterwards the caller has to reference it.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Load Asset")
+	void LoadAssetAsync(const FOnArticyAssetLoaded& OnLoaded) const;
+	void LoadAssetAsync(FArticyAssetLoadedCallback OnLoaded) const;
+
+	/**
+	 * Starts streaming all given assets which are not loaded yet. The assets are kept in memory
+	 * as long as the returned handle is, so a later LoadAsset does not block.
+	 */
+	static TSharedPtr<FStreamableHandle> PrefetchAssets(const TArray<const UArticyAsset*>& Assets);
+
+	/** The object path of the referenced asset. */
+	FSoftObjectPath GetAssetPath() const;
+
+	/** Returns the object path of the asset with the given AssetRef in the articy resources folder. */
+	static FSoftObjectPath MakeAssetPath(const FString& AssetRef);
+
+	virtual void PostLoad() override;
 	
 	/** The relative path of the referenced asset. */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Meta Data")
@@ -61,6 +90,9 @@ public:
 	/** The category of the referenced asset. */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Meta Data")
 	EArticyAssetCategory Category;
+	/** The object path of the referenced asset, generated from AssetRef on import. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Meta Data")
+	FSoftObjectPath AssetPath;
 
 private:
 	UPROPERTY(Transient, VisibleAnywhere, Category = "Articy")
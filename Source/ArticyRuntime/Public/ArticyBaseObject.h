@@ -36,7 +36,8 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Articy")
 	FArticyType GetArticyType() const;
 
-	FArticyType ArticyType;
+	/** Returns the type of this object without copying it, it is shared by all objects of the same class (see UArticyTypeSystem). */
+	const FArticyType& GetArticyTypeRef() const;
 
 protected:
 	virtual void InitFromJson(TSharedPtr<FJsonValue> Json) { }
@@ -64,4 +65,13 @@ class ARTICYRUNTIME_API UArticyBaseFeature : public UArticyBaseObject
 {
 	GENERATED_BODY()
 
+public:
+	/** Redirects writes to the matching feature of the owner's private copy, if the owner is shared. */
+	IArticyReflectable* PrepareForWrite() override;
+	/** Redirects reads to the matching feature of the owner's private copy, once it exists. */
+	const IArticyReflectable* GetReadTarget() const override;
+
+private:
+	/** Returns the feature with the same name in Owner, or this if there is none. */
+	UArticyBaseFeature* FindInOwner(UObject* Owner) const;
 };
@@ -10,9 +10,11 @@
 #include "ArticyObject.h"
 #include "ArticyPackage.h"
 #include "AssetRegistry/AssetData.h"
+#include "Containers/Ticker.h"
 #include "ArticyDatabase.generated.h"
 
 class UArticyExpressoScripts;
+class UArticyCloneableObject;
 struct FArticyId;
 class UArticyGlobalVariables;
 class UArticyAlternativeGlobalVariables;
@@ -52,13 +54,22 @@ public:
 	 */
 	explicit FArticyShadowableObject(UArticyObject* Object, int32 CloneId, UObject* Outer = nullptr);
 
+	/** Replaces the unshadowed object (Shadows[0]), keeping all shadow copies. */
+	void SetUnshadowed(UArticyObject* Object);
+
 	/**
-	 * Returns the requested shadow.
+	 * Returns the requested shadow. Owner is the container holding this object in its Clones,
+	 * new shadow copies are removed through it when the shadow state is popped.
 	 */
-	UArticyObject* Get(const IShadowStateManager* ShadowManager, bool ForceUnshadowed = false) const;
+	UArticyObject* Get(const IShadowStateManager* ShadowManager, const UArticyCloneableObject* Owner, bool ForceUnshadowed = false) const;
 
 private:
 
+	friend class UArticyCloneableObject;
+
+	/** Removes the most recent shadow copy. */
+	void PopShadowCopy();
+
 	/**
 	 * The original [0] object and its shadows.
 	 * Shadows are guaranteed to be stored in ascending order, but
@@ -78,6 +89,22 @@ class ARTICYRUNTIME_API UArticyCloneableObject : public UObject
 
 public:
 	void Init(UArticyObject* InitialClone) { AddClone(InitialClone, 0); }
+	/**
+	 * Uses the (immutable) package asset as clone 0 without copying it.
+	 * A private copy is created by Materialize once the object is written to.
+	 * Falls back to an immediate copy if the asset is already shared by another container.
+	 */
+	void InitShared(UArticyObject* Asset);
+
+	/** Returns true if clone 0 is still the shared package asset. */
+	bool IsShared() const;
+	/**
+	 * Replaces the shared package asset with a private copy and returns that copy.
+	 * If clone 0 is already private, it is returned as is.
+	 */
+	UArticyObject* Materialize();
+	/** Stops sharing the package asset, e.g. when the container is unloaded. */
+	void ReleaseShared();
 
 	//========================================//
 
@@ -102,8 +129,18 @@ private:
 	UPROPERTY(VisibleAnywhere, Category = "Articy")
 	TMap<int32, FArticyShadowableObject> Clones;
 
+	/**
+	 * The package asset used as clone 0 until it is first written to.
+	 * Kept afterwards, as the asset redirects to the copy until it is released.
+	 */
+	UPROPERTY(Transient)
+	UArticyObject* SharedAsset = nullptr;
+
 	/** Adds a clone to the Clones map. */
 	void AddClone(UArticyObject* Clone, int32 CloneId);
+
+	/** Undo log callback, removes the most recent shadow copy of the clone CloneId. */
+	static void PopShadowCopy(UObject* Owner, int32 CloneId);
 };
 
 /**
@@ -119,6 +156,134 @@ public:
 	TArray<UArticyCloneableObject *> Objects;
 };
 
+/** How object queries of the database treat objects without a clone with the requested CloneId. */
+enum class EArticyCloneMode : uint8
+{
+	/** Objects without the clone are skipped. */
+	ExistingOnly,
+	/** Missing clones are created. Only possible on the game thread. */
+	CreateMissing
+};
+
+/**
+ * The loaded objects of a class and its subclasses, see UArticyDatabase::GetObjectsOfClassView.
+ * Objects without a clone with the requested CloneId are skipped.
+ * A view must not be kept across loading or unloading packages.
+ * Off the game thread, shadow states are ignored, as shadow copies can only be created on the game thread.
+ * Views can be iterated off the game thread only while the game thread leaves the database alone, see GetObjects.
+ */
+template<typename T>
+class TArticyObjectsOfClassView
+{
+public:
+	typedef TArray<const TArray<UArticyCloneableObject*>*> FClassObjects;
+
+	TArticyObjectsOfClassView(const IShadowStateManager* InShadowManager, const FClassObjects& InClasses, int32 InCloneId, bool bInForceUnshadowed)
+		: ShadowManager(InShadowManager), Classes(InClasses), CloneId(InCloneId), bForceUnshadowed(bInForceUnshadowed || !IsInGameThread()) {}
+
+	class FIterator
+	{
+	public:
+		FIterator(const TArticyObjectsOfClassView& InView, int32 InClassIndex) : View(InView), ClassIndex(InClassIndex) { SkipMissing(); }
+
+		T* operator*() const { return Current; }
+		FIterator& operator++() { ++ObjectIndex; SkipMissing(); return *this; }
+		bool operator!=(const FIterator& Other) const { return ClassIndex != Other.ClassIndex || ObjectIndex != Other.ObjectIndex; }
+
+	private:
+		const TArticyObjectsOfClassView& View;
+		int32 ClassIndex;
+		int32 ObjectIndex = 0;
+		T* Current = nullptr;
+
+		/** Advances to the next object which has the requested clone, or to the end. */
+		void SkipMissing()
+		{
+			for(; ClassIndex < View.Classes.Num(); ++ClassIndex, ObjectIndex = 0)
+			{
+				const auto& Objects = *View.Classes[ClassIndex];
+				for(; ObjectIndex < Objects.Num(); ++ObjectIndex)
+				{
+					//the index only contains objects of T and its subclasses
+					Current = static_cast<T*>(Objects[ObjectIndex]->Get(View.ShadowManager, View.CloneId, View.bForceUnshadowed));
+					if(Current)
+						return;
+				}
+			}
+			Current = nullptr;
+		}
+	};
+
+	FIterator begin() const { return FIterator(*this, 0); }
+	FIterator end() const { return FIterator(*this, Classes.Num()); }
+
+	/** The number of loaded objects, including those without the requested clone. */
+	int32 NumObjects() const
+	{
+		int32 Num = 0;
+		for(const auto Objects : Classes)
+			Num += Objects->Num();
+		return Num;
+	}
+
+private:
+	const IShadowStateManager* ShadowManager;
+	FClassObjects Classes;
+	int32 CloneId;
+	bool bForceUnshadowed;
+};
+
+/**
+ * The position of a flow node or pin in the flow graph of a loaded package.
+ * Graph points into the package and is only valid while the package stays loaded, don't keep locations around.
+ */
+struct FArticyFlowGraphLocation
+{
+	const FArticyFlowGraph* Graph = nullptr;
+	/** Index into Graph->Nodes, or into Graph->Pins if bIsPin is set. */
+	int32 Index = INDEX_NONE;
+	bool bIsPin = false;
+};
+
+/**
+ * The package and index of a flow node or pin, as stored by the database.
+ */
+struct FArticyFlowGraphEntry
+{
+	/** Index into the package names of the database's flow graphs. */
+	int32 PackageIndex = INDEX_NONE;
+	/** Index into the Nodes of the package's flow graph, or into its Pins if bIsPin is set. */
+	int32 Index = INDEX_NONE;
+	bool bIsPin = false;
+};
+
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FOnArticyPackageLoaded, const FString&, PackageName, bool, bSucceeded);
+
+/** Callback for LoadPackageAsync, called on the game thread once the package is loaded (or failed to load). */
+typedef TFunction<void(const FString& PackageName, bool bSucceeded)> FArticyPackageLoadedCallback;
+
+/**
+ * Bookkeeping of a package which is loaded by LoadPackageAsync.
+ */
+USTRUCT()
+struct FArticyPendingPackageLoad
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY()
+	UArticyPackage* Package = nullptr;
+
+	/** The clone containers prepared so far, they are added to the database once all are ready. */
+	UPROPERTY()
+	TArray<UArticyCloneableObject*> Containers;
+
+	/** The index of the next package asset to prepare a clone container for. */
+	int32 NextAssetIndex = 0;
+
+	TArray<FArticyPackageLoadedCallback> Callbacks;
+};
+
 /**
  * The database is used for accessing or cloning any articy object.
  */
@@ -159,6 +324,8 @@ public:
 	UFUNCTION(BlueprintPure, meta=(DisplayName="Is in shadow state?"), Category = "Script Methods")
 	bool IsInShadowState() const { return GetShadowLevel()  > 0; }
 
+	bool UsesPropertyUndoLog() const override;
+
 	UFUNCTION(BlueprintPure, meta = (DisplayName="Get imported package names"), Category = "Articy")
 	TArray<FString> GetImportedPackageNames() const;
 
@@ -185,7 +352,27 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Articy")
 	virtual void LoadPackage(FString PackageName);
 
-	/** Load a package of a given name. */
+	/**
+	 * Load a package of a given name without blocking the game thread for long.
+	 * The package asset references its objects directly, so they are in memory with the package already;
+	 * what is spread over multiple frames is preparing their clone containers (see UArticyPluginSettings::AsyncLoadBudgetMs).
+	 * All objects become available at once, right before OnLoaded is called.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Articy")
+	void LoadPackageAsync(FString PackageName, const FOnArticyPackageLoaded& OnLoaded);
+	void LoadPackageAsync(const FString& PackageName, FArticyPackageLoadedCallback OnLoaded = nullptr);
+
+	/** Returns true if the package is currently loaded by LoadPackageAsync. */
+	UFUNCTION(BlueprintPure, Category = "Articy")
+	bool IsPackageLoading(const FString& PackageName) const { return PendingPackageLoads.Contains(PackageName); }
+
+	/** Finds the flow node or pin with this id in the flow graphs of the loaded packages, returns false if there is none. */
+	bool FindInFlowGraph(const FArticyId& Id, FArticyFlowGraphLocation& OutLocation) const;
+
+	/**
+	 * Unload a package of a given name. If the package is still loading (see LoadPackageAsync),
+	 * the load is cancelled instead, its OnLoaded is not called, and true is returned as well.
+	 */
 	UFUNCTION(BlueprintCallable, Category = "Articy")
 	virtual bool UnloadPackage(const FString PackageName, const bool bQuickUnload);
 
@@ -233,7 +420,7 @@ public:
 	/**
 	 * Get all objects with a given TechnicalName.
 	 * If a CloneId other than 0 is provided, copies of the objects with this index must exist,
-	 * otherwise null-pointers are returned instead.
+	 * otherwise they will be not added to the result.
 	 * Note: this allocates a new TArray, use the other variant if you already have an array
 	 * to fill the objects with!
 	 */
@@ -242,7 +429,7 @@ public:
 	/**
 	 * Get all objects with a given TechnicalName.
 	 * If a CloneId other than 0 is provided, copies of the objects with this index must exist,
-	 * otherwise null-pointers are returned instead.
+	 * otherwise they will be not added to the result.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Articy", meta = (DeterminesOutputType = "CastTo", AdvancedDisplay = "CloneId"))
 	TArray<UArticyObject*> GetObjects(FName TechnicalName, int32 CloneId = 0, TSubclassOf<class UArticyObject> CastTo = NULL) const;
@@ -270,12 +457,26 @@ public:
 	TArray<UArticyObject*> GetAllObjects() const;
 
 	/**
-	 * Get all objects with a given TechnicalName.
-	 * If a CloneId other than 0 is provided, copies of the objects with this index must exist,
-	 * otherwise null-pointers are returned instead.
+	 * Iterate over all objects of type T and its subclasses, without collecting them into an array.
+	 * If a CloneId other than 0 is provided, objects without a clone with this index are skipped.
+	 */
+	template<typename T>
+	TArticyObjectsOfClassView<T> GetObjectsOfClassView(int32 CloneId = 0) const
+	{
+		return TArticyObjectsOfClassView<T>(this, GetIndexedClasses(T::StaticClass()), CloneId, false);
+	}
+
+	/**
+	 * Adds all objects with a given TechnicalName to Array, which is not cleared first.
+	 * Objects without a clone with the given CloneId are skipped, unless CloneMode is CreateMissing.
+	 *
+	 * Off the game thread, only existing clones are returned and shadow states are ignored.
+	 * The clone containers are not locked: this can only be called off the game thread while the game thread
+	 * doesn't load or unload packages, create clones, enter or leave shadow states or write to objects
+	 * (which copies shared objects) at the same time, e.g. from a task the game thread waits for.
 	 */
 	template<typename T = UArticyObject>
-	void GetObjects(TArray<T*>& Array, FName TechnicalName, int32 CloneId = 0) const;
+	void GetObjects(TArray<T*>& Array, FName TechnicalName, int32 CloneId = 0, EArticyCloneMode CloneMode = EArticyCloneMode::ExistingOnly) const;
 	
 	//---------------------------------------------------------------------------//
 
@@ -343,11 +544,62 @@ protected:
 	TMap<FArticyId, UArticyCloneableObject*> LoadedObjectsById;
 	UPROPERTY()
 	TMap<FName, FArticyDatabaseObjectArray> LoadedObjectsByName;
+	/**
+	 * The loaded objects by their exact class. Keys are never removed before all packages are
+	 * unloaded, so the arrays stay in place for the cached class lookups.
+	 */
+	TMap<const UClass*, TArray<UArticyCloneableObject*>> LoadedObjectsByClass;
 	
 	void UnloadAllPackages();
 
+	/** Creates the clone container for a package asset. */
+	UArticyCloneableObject* CreateCloneContainer(UArticyObject* ArticyObject, const bool bCopyOnWrite);
+	/** Adds the prepared clone containers of a package to the loaded objects in one batch. */
+	void CommitLoadedPackage(const FString& PackageName, const TArray<UArticyCloneableObject*>& Containers);
+
+	void BeginDestroy() override;
+	void PostDuplicate(bool bDuplicateForPIE) override;
+
 private:
 
+	/** All nodes and pins in the flow graphs of the loaded packages. */
+	TMap<FArticyId, FArticyFlowGraphEntry> LoadedFlowGraphNodes;
+	/** The names of the packages referenced by LoadedFlowGraphNodes, names are only removed with all packages. */
+	TArray<FString> FlowGraphPackageNames;
+
+	/** The arrays of LoadedObjectsByClass of a class and its subclasses, reset whenever a class is added. */
+	mutable TMap<const UClass*, TArticyObjectsOfClassView<UArticyObject>::FClassObjects> IndexedClassesCache;
+	/** Guards IndexedClassesCache, which is filled by queries from any thread. */
+	mutable FRWLock IndexedClassesLock;
+
+	/** Adds a loaded object to LoadedObjectsByClass. */
+	void AddToClassIndex(UArticyCloneableObject* CloneContainer, const UClass* Class);
+	void ResetIndexedClassesCache();
+
+	/** Returns the arrays of LoadedObjectsByClass containing objects of Class or one of its subclasses. */
+	TArticyObjectsOfClassView<UArticyObject>::FClassObjects GetIndexedClasses(const UClass* Class) const;
+
+	/** Returns the clone CloneId of an object according to CloneMode, see GetObjects. */
+	UArticyObject* GetClone(UArticyCloneableObject* CloneContainer, int32 CloneId, EArticyCloneMode CloneMode) const;
+
+	void AddFlowGraph(const FString& PackageName, const FArticyFlowGraph& Graph);
+	void RemoveFlowGraph(const FString& PackageName, const FArticyFlowGraph& Graph);
+
+	/** Packages currently loaded by LoadPackageAsync. */
+	UPROPERTY(Transient)
+	TMap<FString, FArticyPendingPackageLoad> PendingPackageLoads;
+
+#if ENGINE_MAJOR_VERSION >= 5
+	FTSTicker::FDelegateHandle PendingLoadsTickerHandle;
+#else
+	FDelegateHandle PendingLoadsTickerHandle;
+#endif
+
+	/** Prepares clone containers of all pending packages within the time budget. */
+	bool TickPendingPackageLoads(float DeltaTime);
+	/** Finishes (or cancels) a pending package load and notifies its callbacks. */
+	void FinishPendingPackageLoad(const FString& PackageName, bool bSucceeded);
+
 	static TMap<TWeakObjectPtr<UWorld>, TWeakObjectPtr<UArticyDatabase>> Clones;
 	static TWeakObjectPtr<UArticyDatabase> PersistentClone;
 
@@ -377,9 +629,7 @@ private:
 template<typename T>
 TArray<T*> UArticyDatabase::GetObjects(FName TechnicalName, int32 CloneId) const
 {
-	static TArray<T*> Array;
-	Array.Reset();
-	
+	TArray<T*> Array;
 	GetObjects(Array, TechnicalName, CloneId);
 
 	return Array;
@@ -388,41 +638,27 @@ TArray<T*> UArticyDatabase::GetObjects(FName TechnicalName, int32 CloneId) const
 template<typename T>
 TArray<T*> UArticyDatabase::GetObjectsOfClass(int32 CloneId) const
 {
-	TArray<T*> arr;
+	const auto View = GetObjectsOfClassView<T>(CloneId);
 
-	TArray<UArticyCloneableObject*> ArticyObjects;
-	LoadedObjectsById.GenerateValueArray(ArticyObjects);
-
-	for (auto obj : ArticyObjects)
-	{
-		/*if (obj->GetCloneId() == CloneId && Cast<T>(obj))
-		{
-			arr.Add(obj);
-		}*/
+	TArray<T*> arr;
+	arr.Reserve(View.NumObjects());
+	for (T* Object : View)
+		arr.Add(Object);
 
-		UArticyObject* Object = obj->Get(this, CloneId, false);
-		if(Object)
-		{
-			T* TypedObject = Cast<T>(Object);
-			if(TypedObject)
-			{
-				arr.Add(TypedObject);
-			}
-		}
-	}
 	return arr;
 }
 
 template<typename T>
-void UArticyDatabase::GetObjects(TArray<T*>& Array, FName TechnicalName, int32 CloneId) const
+void UArticyDatabase::GetObjects(TArray<T*>& Array, FName TechnicalName, int32 CloneId, EArticyCloneMode CloneMode) const
 {
 	//find all objects with this name
 	auto arr = LoadedObjectsByName.Find(TechnicalName);
 	if(arr)
 	{
+		Array.Reserve(Array.Num() + arr->Objects.Num());
 		for(auto obj : arr->Objects)
 		{
-			auto clone = Cast<T>(obj->Clone(this, CloneId));
+			auto clone = Cast<T>(GetClone(obj, CloneId, CloneMode));
 			if(clone)
 				Array.Add(clone);
 		}
@@ -7,88 +7,167 @@
 #include "Internationalization/Regex.h"
 #include "ArticyObject.h"
 #include "ArticyDatabase.h"
+#include <atomic>
 
 #include "ArticyExpressoScripts.generated.h"
 
 class UArticyString;
 class UArticyInt;
 class UArticyBool;
+class FArticyGvString;
+class FArticyGvInt;
+class FArticyGvBool;
 class UArticyExpressoScripts;
 struct ExpressoType;
 
+/**
+ * A property path ("Property" or "Feature.Property") for getProp and setProp, split into names once.
+ * Generated scripts create one per literal path with ARTICY_PROPERTY_PATH, so they don't split
+ * and hash the path on every access.
+ */
+struct ARTICYRUNTIME_API FArticyPropertyPath
+{
+    explicit FArticyPropertyPath(const FString& InPath);
+
+    FString Path;
+    /** The feature holding the property, or NAME_None if the path accesses a property of the object itself. */
+    FName Feature;
+    FName Property;
+};
+
+/** A property path literal of a generated script, created the first time the script runs. */
+#define ARTICY_PROPERTY_PATH(Literal) ([]() -> const FArticyPropertyPath& { static const FArticyPropertyPath Path{ FString(Literal) }; return Path; }())
+
+/**
+ * The value type of expresso scripts, a 16 byte tagged value. Numbers and bools are stored inline,
+ * so they are copied and compared without allocations. Strings are held by a handle to a shared,
+ * reference counted payload, which is only copied before it is modified (see GetString).
+ */
 struct ARTICYRUNTIME_API ExpressoType
 {
+private:
+    struct FStringPayload
+    {
+        FString Value;
+        std::atomic<int32> RefCount { 1 };
+    };
+
+public:
     union
     {
         bool BoolValue;
         int64 IntValue = 0;
         double FloatValue;
+        /** Only valid if Type is String, use GetString to access it. */
+        FStringPayload* StringPayload;
     };
-    FString StringValue;
 
-    enum EType
+    enum EType : uint8
     {
         Undefined, Bool, Int, Float, String
     } Type = Undefined;
 
-    virtual bool& GetBool();
-    virtual const bool& GetBool() const;
+    /** Returns the bool value, or false if this is not a bool. */
+    FORCEINLINE bool GetBool() const { return Type == Bool && BoolValue; }
+    /** Returns the int value, or 0 if this is not an int. */
+    FORCEINLINE int64 GetInt() const { return Type == Int ? IntValue : 0; }
+    /** Returns the float value, or 0 if this is not a float. */
+    FORCEINLINE double GetFloat() const { return Type == Float ? FloatValue : 0.0; }
 
-    virtual int64& GetInt();
-    virtual const int64& GetInt() const;
+    /**
+     * Returns the string value, which is copied first if it is shared with another ExpressoType.
+     * If this is not a string, an empty scratch string is returned and this is left unchanged.
+     */
+    FString& GetString();
+    /** Returns the string value, or an empty string if this is not a string. */
+    FORCEINLINE const FString& GetString() const { return Type == String ? StringPayload->Value : EmptyString; }
 
-    virtual double& GetFloat();
-    virtual const double& GetFloat() const;
+    FString ToString() const;
 
-    virtual FString& GetString();
-    virtual const FString& GetString() const;
 
-    virtual FString ToString() const;
+    //---------------------------------------------------------------------------//
+
+    FORCEINLINE ExpressoType() {}
+    FORCEINLINE ~ExpressoType()
+    {
+        if (Type == String)
+            ReleaseString();
+    }
 
+    FORCEINLINE ExpressoType(const ExpressoType& Other)
+    {
+        FMemory::Memcpy(this, &Other, sizeof(ExpressoType));
+        if (Type == String)
+            StringPayload->RefCount.fetch_add(1, std::memory_order_relaxed);
+    }
 
-    //---------------------------------------------------------------------------//
+    FORCEINLINE ExpressoType(ExpressoType&& Other)
+    {
+        FMemory::Memcpy(this, &Other, sizeof(ExpressoType));
+        Other.Type = Undefined;
+    }
 
-    ExpressoType();
-    virtual ~ExpressoType();
+    FORCEINLINE ExpressoType& operator=(ExpressoType Other)
+    {
+        FMemory::Memswap(this, &Other, sizeof(ExpressoType));
+        return *this;
+    }
 
     //initialize from object and property
     ExpressoType(UArticyBaseObject* Object, const FString& Property);
+    ExpressoType(UArticyBaseObject* Object, const FArticyPropertyPath& Property);
     
     // ReSharper disable CppNonExplicitConvertingConstructor
 
     //implicit conversion from value type
-    ExpressoType(const bool& Value);
-    ExpressoType(const int64& Value);
-    ExpressoType(const int32& Value);
-    ExpressoType(const int16& Value);
-    ExpressoType(const int8& Value);
-    ExpressoType(const uint64& Value);
-    ExpressoType(const uint32& Value);
-    ExpressoType(const uint16& Value);
-    ExpressoType(const uint8& Value);
-    ExpressoType(const double& Value);
-    ExpressoType(const float& Value);
+    FORCEINLINE ExpressoType(const bool& Value) : BoolValue(Value), Type(Bool) {}
+    FORCEINLINE ExpressoType(const int64& Value) : IntValue(Value), Type(Int) {}
+    FORCEINLINE ExpressoType(const int32& Value) : ExpressoType(int64(Value)) {}
+    FORCEINLINE ExpressoType(const int16& Value) : ExpressoType(int64(Value)) {}
+    FORCEINLINE ExpressoType(const int8& Value) : ExpressoType(int64(Value)) {}
+    FORCEINLINE ExpressoType(const uint64& Value) : ExpressoType(int64(Value)) {}
+    FORCEINLINE ExpressoType(const uint32& Value) : ExpressoType(int64(Value)) {}
+    FORCEINLINE ExpressoType(const uint16& Value) : ExpressoType(int64(Value)) {}
+    FORCEINLINE ExpressoType(const uint8& Value) : ExpressoType(int64(Value)) {}
+    FORCEINLINE ExpressoType(const double& Value) : FloatValue(Value), Type(Float) {}
+    FORCEINLINE ExpressoType(const float& Value) : ExpressoType(double(Value)) {}
     ExpressoType(const FString& Value);
+    ExpressoType(FString&& Value);
     ExpressoType(const FText& Value);
     ExpressoType(const FName& Value);
     ExpressoType(const UArticyPrimitive* Object);
     ExpressoType(const UArticyString& Value);
     ExpressoType(const UArticyInt& Value);
     ExpressoType(const UArticyBool& Value);
+    ExpressoType(const FArticyGvString& Value);
+    ExpressoType(const FArticyGvInt& Value);
+    ExpressoType(const FArticyGvBool& Value);
     ExpressoType(const FArticyId& Value);
     
     //implicit conversion to value type
-    explicit operator bool() const;
-    explicit operator int64() const;
-    explicit operator int8() const;
-    explicit operator uint8() const;
-    explicit operator int16() const;
-    explicit operator uint16() const;
-    explicit operator int32() const;
-    explicit operator uint32() const;
-    explicit operator uint64() const;
-    explicit operator double() const;
-    explicit operator float() const;
+    FORCEINLINE explicit operator bool() const
+    {
+        ensure(Type == Bool);
+        return GetBool();
+    }
+    FORCEINLINE explicit operator int64() const
+    {
+        ensure(Type == Float || Type == Int || Type == String);
+        return Type == Int ? GetInt() : Type == Float ? int64(GetFloat()) : ParseObjectId();
+    }
+    FORCEINLINE explicit operator int8() const { return int64(*this); }
+    FORCEINLINE explicit operator uint8() const { return int64(*this); }
+    FORCEINLINE explicit operator int16() const { return int64(*this); }
+    FORCEINLINE explicit operator uint16() const { return int64(*this); }
+    FORCEINLINE explicit operator int32() const { return int64(*this); }
+    FORCEINLINE explicit operator uint32() const { return int64(*this); }
+    FORCEINLINE explicit operator uint64() const { return int64(*this); }
+    FORCEINLINE explicit operator double() const
+    {
+        ensure(Type == Float || Type == Int);
+        return Type == Float ? GetFloat() : double(GetInt());
+    }
+    FORCEINLINE explicit operator float() const { return double(*this); }
     explicit operator FString() const;
     explicit operator FText() const;
     explicit operator FName() const;
@@ -135,7 +214,8 @@ struct ARTICYRUNTIME_API ExpressoType
      */
     static TMap<FName, Definition> Definitions;
 
-    const Definition& GetDefinition(const FName& CppType) const;
+    /** Returns the definition of a cpp type, called with PropertyHandlesLock held. */
+    static const Definition& GetDefinition(const FName& CppType);
 
     template<typename T>
     static void AddDefinition(const FName& CppType);
@@ -143,10 +223,53 @@ struct ARTICYRUNTIME_API ExpressoType
     //---------------------------------------------------------------------------//
 
     /** Set the property with a given name, without knowing the type. */
-    void SetValue(UArticyBaseObject* Object, FString Property) const;
+    void SetValue(UArticyBaseObject* Object, const FString& Property) const;
+    void SetValue(UArticyBaseObject* Object, const FArticyPropertyPath& Property) const;
+
+    struct PropertyHandle;
+
+    /**
+     * Resolves a property path on Object, and changes Object to the feature if needed.
+     * The resolved properties and their definitions are cached per class and name, so scripts
+     * don't need to look up the properties and the cpp type on every access.
+     * Returns false if the property can not be accessed.
+     */
+    static bool ResolveProperty(UArticyBaseObject*& Object, const FArticyPropertyPath& Path, PropertyHandle& OutHandle);
+
+private:
+
+    /** The resolved properties, by class and property name. Guarded by PropertyHandlesLock, as scripts can run on any thread. */
+    static TMap<TTuple<const UClass*, FName>, PropertyHandle> PropertyHandles;
+    static FRWLock PropertyHandlesLock;
+
+    static const FString EmptyString;
+
+#if !UE_BUILD_SHIPPING
+    /** The number of string payloads allocated so far, reported by the ArticyRuntime.ExpressoBenchmark command. */
+    static std::atomic<int64> NumStringPayloads;
+
+    friend struct FArticyExpressoBenchmark;
+#endif
 
-    /** If Property contains a dot, this method modifies Object and Property so a fueature is accessed instead. */
-    static UArticyBaseObject* TryFeatureReroute(UArticyBaseObject* Object, FString& Property);
+    /** Releases the string payload, and deletes it if this was the last reference. */
+    void ReleaseString();
+
+    /** Converts the result of getObj (Id_CloneId) to the object id. */
+    int64 ParseObjectId() const;
+};
+
+static_assert(sizeof(ExpressoType) == 16, "ExpressoType should stay a 16 byte tagged value.");
+
+struct ExpressoType::PropertyHandle
+{
+    /**
+     * The class Property and Def were resolved for (the feature class, if the path accesses a feature).
+     * It is weak, so a class which was replaced (e.g. by hot reload or a reimport) is not mistaken
+     * for a new class at the same address.
+     */
+    TWeakObjectPtr<const UClass> Class;
+    FProperty* Property = nullptr;
+    const Definition* Def = nullptr;
 };
 
 struct ExpressoType::Definition
@@ -187,6 +310,320 @@ void ExpressoType::AddDefinition(const FName& CppType)
     Definitions.Add(CppType, def);
 }
 
+//---------------------------------------------------------------------------//
+
+inline ExpressoType ExpressoType::operator-() const
+{
+	switch (Type)
+	{
+	case Undefined:
+		break;
+	case Bool:
+		return ExpressoType(!GetBool());
+	case Int:
+		return ExpressoType(-GetInt());
+	case Float:
+		return ExpressoType(-GetFloat());
+	case String:
+		return ExpressoType(FString(""));
+
+	default:
+		ensureMsgf(false, TEXT("Unknown ArticyExpressoType!"));
+	}
+
+	return ExpressoType{};
+}
+
+//---------------------------------------------------------------------------//
+
+inline bool ExpressoType::operator==(const ExpressoType& Other) const
+{
+	switch (Type)
+	{
+	case Undefined:
+		break;
+
+	case Bool:
+		return GetBool() == Other.GetBool();
+	case Int:
+		switch (Other.Type)
+		{
+		case Int:
+			return GetInt() == Other.GetInt();
+		case Float:
+			return GetInt() == Other.GetFloat();
+		default:
+			ensureMsgf(false, TEXT("Uncomparable expresso types!"));
+		}
+	case Float:
+		switch (Other.Type)
+		{
+		case Float:
+			return GetFloat() == Other.GetFloat();
+		case Int:
+			return GetFloat() == Other.GetInt();
+		default:
+			ensureMsgf(false, TEXT("Uncomparable expresso types!"));
+		}
+	case String:
+		//copies of the same string share the payload
+		return (Other.Type == String && StringPayload == Other.StringPayload) || GetString() == Other.GetString();
+
+	default:
+		ensureMsgf(false, TEXT("Unknown ArticyExpressoType!"));
+	}
+
+	return false;
+}
+
+inline bool ExpressoType::operator!=(const ExpressoType& Other) const
+{
+	return !(*this == Other);
+}
+
+inline bool ExpressoType::operator<(const ExpressoType& Other) const
+{
+	switch (Type)
+	{
+	case Undefined:
+		break;
+
+	case Bool:
+		return GetBool() < Other.GetBool();
+	case Int:
+		switch (Other.Type)
+		{
+		case Int:
+			return GetInt() < Other.GetInt();
+		case Float:
+			return GetInt() < Other.GetFloat();
+		default:
+			ensureMsgf(false, TEXT("Uncomparable expresso types!"));
+		}
+	case Float:
+		switch (Other.Type)
+		{
+		case Float:
+			return GetFloat() < Other.GetFloat();
+		case Int:
+			return GetFloat() < Other.GetInt();
+		default:
+			ensureMsgf(false, TEXT("Uncomparable expresso types!"));
+		}
+	case String:
+		return GetString() < Other.GetString();
+
+	default:
+		ensureMsgf(false, TEXT("Unknown ArticyExpressoType!"));
+	}
+
+	return false;
+}
+
+inline bool ExpressoType::operator>(const ExpressoType& Other) const
+{
+	switch (Type)
+	{
+	case Undefined:
+		break;
+
+	case Bool:
+		return GetBool() > Other.GetBool();
+	case Int:
+		switch (Other.Type)
+		{
+		case Int:
+			return GetInt() > Other.GetInt();
+		case Float:
+			return GetInt() > Other.GetFloat();
+		default:
+			ensureMsgf(false, TEXT("Uncomparable expresso types!"));
+		}
+	case Float:
+		switch (Other.Type)
+		{
+		case Float:
+			return GetFloat() > Other.GetFloat();
+		case Int:
+			return GetFloat() > Other.GetInt();
+		default:
+			ensureMsgf(false, TEXT("Uncomparable expresso types!"));
+		}
+	case String:
+		return GetString() > Other.GetString();
+
+	default:
+		ensureMsgf(false, TEXT("Unknown ArticyExpressoType!"));
+	}
+
+	return false;
+}
+
+//---------------------------------------------------------------------------//
+
+inline ExpressoType ExpressoType::operator&&(const ExpressoType& Other) const
+{
+	switch (Type)
+	{
+	case Bool:
+		return ExpressoType(GetBool() && Other.GetBool());
+	case Int:
+		return ExpressoType(GetInt() && Other.GetInt());
+	case Float:
+		return ExpressoType(GetFloat() && Other.GetFloat());
+
+	case String:
+	case Undefined:
+		break;
+
+	default:
+		ensureMsgf(false, TEXT("Unknown ArticyExpressoType!"));
+	}
+
+	return ExpressoType{};
+}
+
+inline ExpressoType ExpressoType::operator||(const ExpressoType& Other) const
+{
+	switch (Type)
+	{
+	case Bool:
+		return ExpressoType(GetBool() || Other.GetBool());
+	case Int:
+		return ExpressoType(GetInt() || Other.GetInt());
+	case Float:
+		return ExpressoType(GetFloat() || Other.GetFloat());
+
+	case String:
+	case Undefined:
+		break;
+
+	default:
+		ensureMsgf(false, TEXT("Unknown ArticyExpressoType!"));
+	}
+
+	return ExpressoType{};
+}
+
+inline ExpressoType ExpressoType::operator^(const ExpressoType& Other) const
+{
+	switch (Type)
+	{
+	case Bool:
+		return ExpressoType(GetBool() ^ Other.GetBool());
+	case Int:
+		return ExpressoType(GetInt() ^ Other.GetInt());
+
+	case Float:
+	case String:
+	case Undefined:
+		break;
+
+	default:
+		ensureMsgf(false, TEXT("Unknown ArticyExpressoType!"));
+	}
+
+	return ExpressoType{};
+}
+
+inline ExpressoType ExpressoType::operator+(const ExpressoType& Other) const
+{
+	switch (Type)
+	{
+	case Undefined:
+		break;
+
+	case Bool:
+		return ExpressoType(GetBool() || Other.GetBool());
+	case Int:
+		return ExpressoType(GetInt() + Other.GetInt());
+	case Float:
+		return ExpressoType(GetFloat() + Other.GetFloat());
+	case String:
+		return ExpressoType(GetString() + Other.GetString());
+
+	default:
+		ensureMsgf(false, TEXT("Unknown ArticyExpressoType!"));
+	}
+
+	return ExpressoType{};
+}
+
+inline ExpressoType ExpressoType::operator-(const ExpressoType& Other) const
+{
+	return *this + (-Other);
+}
+
+inline ExpressoType ExpressoType::operator*(const ExpressoType& Other) const
+{
+	switch (Type)
+	{
+	case Bool:
+		return *this && Other;
+	case Int:
+		return ExpressoType(GetInt() * Other.GetInt());
+	case Float:
+		return ExpressoType(GetFloat() * Other.GetFloat());
+
+	case String:
+	case Undefined:
+		break;
+
+	default:
+		ensureMsgf(false, TEXT("Unknown ArticyExpressoType!"));
+	}
+
+	return ExpressoType{};
+}
+
+inline ExpressoType ExpressoType::operator/(const ExpressoType& Other) const
+{
+	switch (Type)
+	{
+	case Int:
+		return ExpressoType(GetInt() / Other.GetInt());
+	case Float:
+		return ExpressoType(GetFloat() / Other.GetFloat());
+
+	case Bool:
+	case String:
+	case Undefined:
+		break;
+
+	default:
+		ensureMsgf(false, TEXT("Unknown ArticyExpressoType!"));
+	}
+
+	return ExpressoType{};
+}
+
+inline ExpressoType ExpressoType::operator%(const ExpressoType& Other) const
+{
+	switch (Type)
+	{
+	case Int:
+		return ExpressoType(GetInt() % Other.GetInt());
+	case Float:
+		float OutIntPart;
+		return ExpressoType(FMath::Modf(GetFloat(), &OutIntPart));
+
+	case Bool:
+	case String:
+	case Undefined:
+		break;
+
+	default:
+		ensureMsgf(false, TEXT("Unknown ArticyExpressoType!"));
+	}
+
+	return ExpressoType{};
+}
+
+inline bool ExpressoType::operator<=(const ExpressoType& Other) const { return !(*this > Other); }
+inline bool ExpressoType::operator>=(const ExpressoType& Other) const { return !(*this < Other); }
+
+//---------------------------------------------------------------------------//
+
 FORCEINLINE int operator+(const int& Lhs, const ExpressoType& Rhs)
 {
 	return Lhs + (int)Rhs;
@@ -232,6 +669,40 @@ FORCEINLINE float operator/(const float& Lhs, const ExpressoType& Rhs)
 	return Lhs / (float)Rhs;
 }
 
+/**
+ * What a fragment needs from the context of the expresso scripts, determined by the generator.
+ * The context a fragment does not use is neither set up nor reset when it is run.
+ */
+enum class EArticyExpressoFragmentUsage : uint8
+{
+	/** A constant fragment, e.g. just "true" or a comment. */
+	None = 0,
+	/** Accesses global variables, which need SetGV. */
+	GlobalVariables = 1 << 0,
+	/** Uses self or speaker, which need SetCurrentObject and SetSpeaker. */
+	CurrentObject = 1 << 1,
+	/** Calls user methods, which need the methods provider. */
+	UserMethods = 1 << 2,
+
+	All = GlobalVariables | CurrentObject | UserMethods
+};
+ENUM_CLASS_FLAGS(EArticyExpressoFragmentUsage);
+
+/**
+ * A condition or instruction, generated as a member function of the expresso scripts class.
+ * The generated dispatch tables are sorted by Hash, so a fragment is found by binary search,
+ * and its index can be stored on the objects referencing it.
+ */
+struct FArticyExpressoDispatchEntry
+{
+	/** GetTypeHash of the fragment's original text. */
+	uint32 Hash;
+	/** Runs the fragment on the expresso scripts instance. Instructions always return true. */
+	bool (*Function)(UArticyExpressoScripts* Scripts);
+	/** Defaults to everything for tables generated before fragments were classified. */
+	EArticyExpressoFragmentUsage Usage = EArticyExpressoFragmentUsage::All;
+};
+
 /**
  * The Expresso Scripts class is keeping track of conditions & instructions via hashes and manages parameters
  */
@@ -270,6 +741,35 @@ public:
 	 */
 	bool Execute(const int &InstructionFragmentHash, UArticyGlobalVariables* GV, UObject* MethodProvider) const;
 
+	/**
+	 * Same as Evaluate, but directly calls the condition at ConditionIndex in the dispatch table if its hash matches.
+	 * Falls back to looking up the hash if the index is INDEX_NONE or out of date.
+	 */
+	bool Evaluate(int32 ConditionIndex, const int &ConditionFragmentHash, UArticyGlobalVariables* GV, UObject* MethodProvider) const;
+	/**
+	 * Same as Execute, but directly calls the instruction at InstructionIndex in the dispatch table if its hash matches.
+	 * Falls back to looking up the hash if the index is INDEX_NONE or out of date.
+	 */
+	bool Execute(int32 InstructionIndex, const int &InstructionFragmentHash, UArticyGlobalVariables* GV, UObject* MethodProvider) const;
+
+	/** The generated conditions, sorted by hash. */
+	virtual TArrayView<const FArticyExpressoDispatchEntry> GetConditionTable() const { return {}; }
+	/** The generated instructions, sorted by hash. */
+	virtual TArrayView<const FArticyExpressoDispatchEntry> GetInstructionTable() const { return {}; }
+
+	/** Returns the index of a condition in the dispatch table, or INDEX_NONE. */
+	int32 FindCondition(uint32 ConditionFragmentHash) const { return FindInTable(GetConditionTable(), ConditionFragmentHash); }
+	/** Returns the index of an instruction in the dispatch table, or INDEX_NONE. */
+	int32 FindInstruction(uint32 InstructionFragmentHash) const { return FindInTable(GetInstructionTable(), InstructionFragmentHash); }
+
+	/**
+	 * Returns what the condition needs from the context, e.g. to skip SetCurrentObject if it does not use self or speaker.
+	 * Fragments which are not in the dispatch table are assumed to use everything.
+	 */
+	EArticyExpressoFragmentUsage GetConditionUsage(int32 ConditionIndex, uint32 ConditionFragmentHash) const;
+	/** Same as GetConditionUsage, for instructions. */
+	EArticyExpressoFragmentUsage GetInstructionUsage(int32 InstructionIndex, uint32 InstructionFragmentHash) const;
+
 	/**
 	 * Sets a default method provider, which will be always used whenever scripts get
 	 * evaluated / executed without a valid method provider.
@@ -299,6 +799,7 @@ protected:
 	 */
 	UArticyObject* speaker = nullptr;
 
+	/** Conditions and instructions not in the dispatch tables (the empty ones, or those added by older generated code). */
 	TMap<uint32, TFunction<bool()>> Conditions;
 	TMap<uint32, TFunction<void()>> Instructions;
 
@@ -307,13 +808,17 @@ protected:
 
 	/** Don't change the name, it's called like this in script fragments! */
 	static void setProp(UArticyBaseObject* Object, const FString& Property, const ExpressoType& Value);
+	static void setProp(UArticyBaseObject* Object, const FArticyPropertyPath& Property, const ExpressoType& Value);
 	/** Don't change the name, it's called like this in script fragments! */
 	void setProp(const ExpressoType& Id_CloneId, const FString& Property, const ExpressoType& Value) const;
+	void setProp(const ExpressoType& Id_CloneId, const FArticyPropertyPath& Property, const ExpressoType& Value) const;
 
 	/** Don't change the name, it's called like this in script fragments! */
 	static ExpressoType getProp(UArticyBaseObject* Object, const FString& Property);
+	static ExpressoType getProp(UArticyBaseObject* Object, const FArticyPropertyPath& Property);
 	/** Don't change the name, it's called like this in script fragments! */
 	ExpressoType getProp(const ExpressoType& Id_CloneId, const FString& Property) const;
+	ExpressoType getProp(const ExpressoType& Id_CloneId, const FArticyPropertyPath& Property) const;
 
 	/** Don't change the name, it's called like this in script fragments! */
 	int random(int Min, int Max);
@@ -365,6 +870,9 @@ protected:
 		print(Msg.ToString(), Args...);
 	}
 
+	/** Concatenates the dispatch tables of the generated source file shards and sorts them by hash. */
+	static TArray<FArticyExpressoDispatchEntry> MergeDispatchTables(std::initializer_list<TArrayView<const FArticyExpressoDispatchEntry>> Shards);
+
 	/** Script conditions that are not empty, but rather contain something that evaluates to bool, return that condition. */
 	static const bool& ConditionOrTrue(const bool &Condition) { return Condition; }
 	/** Script conditions that are empty or only contain a comment always return true. */
@@ -382,6 +890,14 @@ private:
 
 	UArticyObject* getObjInternal(const ExpressoType& Id_CloneId) const;
 
+	static int32 FindInTable(TArrayView<const FArticyExpressoDispatchEntry> Table, uint32 Hash);
+
+	/** Returns the fragment at Index in Table, or the one with Hash if the index does not match, or nullptr if there is no such fragment. */
+	static const FArticyExpressoDispatchEntry* FindEntry(TArrayView<const FArticyExpressoDispatchEntry> Table, int32 Index, uint32 Hash);
+
+	/** Runs the fragment, only setting up (and resetting) the context it uses. */
+	bool Dispatch(const FArticyExpressoDispatchEntry& Entry, UArticyGlobalVariables* GV, UObject* MethodProvider) const;
+
 	static void PrintInternal(const FString& msg);
 };
 
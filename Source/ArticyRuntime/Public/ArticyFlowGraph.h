@@ -0,0 +1,148 @@
+//  
+// Copyright (c) 2023 articy Software GmbH & Co. KG. All rights reserved.  
+//
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ArticyBaseTypes.h"
+#include "ArticyFlowGraph.generated.h"
+
+class UArticyObject;
+
+/** What a node in the flow graph does when it is explored. */
+UENUM()
+enum class EArticyFlowGraphNodeKind : uint8
+{
+	/** Continues on all output pins. */
+	Node,
+	/** Continues on the jump target pin. */
+	Jump,
+	/** Evaluates its condition and continues on output pin 0 (true) or 1 (false). */
+	Condition,
+	/** Executes its instruction and continues on all output pins. */
+	Instruction
+};
+
+/**
+ * A flow node (fragment, dialogue, hub, jump, condition, instruction, ...) in the flow graph.
+ */
+USTRUCT()
+struct ARTICYRUNTIME_API FArticyFlowGraphNode
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY()
+	FArticyId Id;
+
+	/** EArticyPausableType of the node. */
+	UPROPERTY()
+	uint8 Type = 0;
+
+	UPROPERTY()
+	EArticyFlowGraphNodeKind Kind = EArticyFlowGraphNodeKind::Node;
+
+	/** The hash of the condition or instruction, if bHasScript is set. */
+	UPROPERTY()
+	int32 ScriptHash = 0;
+	/** The index of the script in the dispatch table of the generated expresso scripts. */
+	UPROPERTY()
+	int32 ScriptIndex = INDEX_NONE;
+	UPROPERTY()
+	bool bHasScript = false;
+
+	/** The input pins are stored contiguously in FArticyFlowGraph::Pins, followed by the output pins. */
+	UPROPERTY()
+	int32 FirstPin = INDEX_NONE;
+	UPROPERTY()
+	int32 NumInputPins = 0;
+	UPROPERTY()
+	int32 NumOutputPins = 0;
+
+	/** The index of the jump target in FArticyFlowGraph::Connections (only for jumps). */
+	UPROPERTY()
+	int32 JumpTarget = INDEX_NONE;
+
+	int32 GetFirstOutputPin() const { return FirstPin + NumInputPins; }
+};
+
+/**
+ * An input or output pin in the flow graph.
+ */
+USTRUCT()
+struct ARTICYRUNTIME_API FArticyFlowGraphPin
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY()
+	FArticyId Id;
+
+	/** The index of the owning node in FArticyFlowGraph::Nodes. */
+	UPROPERTY()
+	int32 Node = INDEX_NONE;
+
+	/** The index of the pin in the owner's InputPins or OutputPins array. */
+	UPROPERTY()
+	int32 PinIndex = 0;
+
+	UPROPERTY()
+	bool bIsInput = true;
+
+	/** The hash of the pin's condition (input) or instruction (output), if bHasScript is set. */
+	UPROPERTY()
+	int32 ScriptHash = 0;
+	/** The index of the script in the dispatch table of the generated expresso scripts. */
+	UPROPERTY()
+	int32 ScriptIndex = INDEX_NONE;
+	UPROPERTY()
+	bool bHasScript = false;
+
+	/** The outgoing connections are stored contiguously in FArticyFlowGraph::Connections. */
+	UPROPERTY()
+	int32 FirstConnection = 0;
+	UPROPERTY()
+	int32 NumConnections = 0;
+};
+
+/**
+ * A connection (or jump) to a target pin.
+ */
+USTRUCT()
+struct ARTICYRUNTIME_API FArticyFlowGraphConnection
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY()
+	FArticyId TargetPinId;
+
+	/** The index of the target pin in FArticyFlowGraph::Pins, or INDEX_NONE if the pin is in another package. */
+	UPROPERTY()
+	int32 TargetPin = INDEX_NONE;
+};
+
+/**
+ * The flow of a package, flattened into arrays which reference each other by index.
+ * It is built once on import, so exploring the flow does not need to go through the
+ * (reflected) pin and connection properties of the flow objects.
+ */
+USTRUCT()
+struct ARTICYRUNTIME_API FArticyFlowGraph
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY()
+	TArray<FArticyFlowGraphNode> Nodes;
+	UPROPERTY()
+	TArray<FArticyFlowGraphPin> Pins;
+	UPROPERTY()
+	TArray<FArticyFlowGraphConnection> Connections;
+
+	/** Rebuilds the graph from all flow objects among the Assets. */
+	void Build(const TArray<UArticyObject*>& Assets);
+
+	bool IsEmpty() const { return Nodes.Num() == 0; }
+};
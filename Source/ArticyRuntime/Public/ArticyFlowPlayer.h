@@ -27,6 +27,29 @@ enum class EArticyPausableType : uint8
 };
 ENUM_CLASS_FLAGS(EArticyPausableType);
 
+/**
+ * Everything the AvailableBranches of a flow player depend on, if branch caching is enabled.
+ */
+struct FArticyBranchCacheKey
+{
+	TWeakObjectPtr<UObject> Cursor;
+	TWeakObjectPtr<UArticyGlobalVariables> GVs;
+	uint8 PauseOn = 0;
+	bool bIgnoreInvalidBranches = true;
+	int32 ExploreLimit = 0;
+
+	/** The database, and its count of property writes (see IShadowStateManager::GetPropertyChangeCount). */
+	TWeakObjectPtr<UArticyDatabase> DB;
+	uint64 PropertyChangeCount = 0;
+
+	/** The variables read during the exploration, and their values at that time. */
+	TArray<TPair<TWeakObjectPtr<const UArticyVariable>, ExpressoType>> ReadValues;
+
+	bool IsValid() const { return Cursor.IsValid() && GVs.IsValid() && DB.IsValid(); }
+	/** True if all read variables still have the values they had during the exploration. */
+	bool ReadValuesUnchanged() const;
+};
+
 USTRUCT(BlueprintType)
 struct ARTICYRUNTIME_API FArticyBranch
 {
@@ -49,6 +72,25 @@ public:
 
 	/** Retrieve the last object in the path. */
 	TScriptInterface<IArticyFlowObject> GetTarget() const;
+
+	/**
+	 * While exploring, the Path is not built yet. Instead, this is the index of the branch's
+	 * last node in the flow player's search tree (INDEX_NONE if not known yet).
+	 */
+	int32 ExploreLeaf = INDEX_NONE;
+};
+
+/**
+ * A node of the search tree recorded while exploring the flow.
+ */
+struct FArticyExploreNode
+{
+	/** The unshadowed node, nodes of the flow graph are only resolved once they are on a materialized path. */
+	IArticyFlowObject* Node = nullptr;
+	/** Index of the node this one was reached from, or INDEX_NONE. */
+	int32 Parent = INDEX_NONE;
+	/** The node in the flow graph, if it was found by walking the flow graph. */
+	FArticyFlowGraphLocation GraphLocation;
 };
 
 /**
@@ -134,6 +176,11 @@ public:
 	 * If the node is submergeable, a submerge is performed.
 	 */
 	TArray<FArticyBranch> Explore(IArticyFlowObject* Node, bool bShadowed, int32 Depth, bool IncludeCurrent = true);
+	/**
+	 * Same as above, but appends the branches to OutBranches. Can only be used during an exploration
+	 * (i.e. from IArticyFlowObject::Explore), the paths of the branches are built once the exploration is done.
+	 */
+	void Explore(IArticyFlowObject* Node, bool bShadowed, int32 Depth, TArray<FArticyBranch>& OutBranches, bool IncludeCurrent = true);
 
 	void SetPauseOn(EArticyPausableType Types);
 	/** Returns true if Node is one of the PauseOn types. */
@@ -164,6 +211,18 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Flow")
 	const TArray<FArticyBranch>& GetAvailableBranches() const { return AvailableBranches; }
 
+	/** Forces the next UpdateAvailableBranches to explore the flow again, see bCacheBranches. */
+	UFUNCTION(BlueprintCallable, Category="Flow")
+	void InvalidateBranchCache() { BranchCache = FArticyBranchCacheKey{}; }
+
+	/**
+	 * Starts streaming the preview images of the nodes on the AvailableBranches and of their speakers.
+	 * They are kept in memory until the next call, so loading them when a branch is shown does not block.
+	 * Other assets referenced by the nodes (e.g. attachments or audio) are not prefetched.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Flow")
+	void PrefetchBranchPreviewImages();
+
 	//---------------------------------------------------------------------------//
 
 	/** Wether bIgnoreInvalidBranches is set. */
@@ -221,6 +280,24 @@ protected:
 	UPROPERTY(EditAnywhere, Category = "Setup")
 	uint8 ShadowLevelLimit = 10;
 
+	/**
+	 * If true, UpdateAvailableBranches keeps the current branches instead of exploring again,
+	 * as long as the cursor, the exploration settings and the values of all global variables read by the last exploration
+	 * are unchanged, and no object property was written (via SetProp or scripts) since.
+	 * Only enable this if conditions do not depend on anything else (direct property writes, script methods, random)!
+	 * Otherwise, call InvalidateBranchCache when such a dependency changes.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Setup")
+	bool bCacheBranches = false;
+
+	/**
+	 * If true, the flow is explored using the flow graphs precompiled on import, instead of
+	 * going through the pins and connections of the flow objects.
+	 * Custom Explore implementations of flow object classes are not called in this mode.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Setup")
+	bool bUseFlowGraph = false;
+
 	/**
 	 * Invalid branches will not be part of the AvailableBranches.
 	 */
@@ -274,6 +351,12 @@ private:
 	UPROPERTY(Transient)
 	TScriptInterface<IArticyFlowObject> Cursor = nullptr;
 
+	/** What the current AvailableBranches were explored with, if bCacheBranches is set. */
+	FArticyBranchCacheKey BranchCache;
+
+	/** Keeps the preview images streamed by PrefetchBranchPreviewImages alive. */
+	TSharedPtr<FStreamableHandle> PrefetchHandle;
+
 	/** Set the Cursor to the object referenced by StartOn. */
 	void SetCursorToStartNode();
 
@@ -286,6 +369,41 @@ private:
 	/** Returns a ptr to the unshadowed object of this node */
 	IArticyFlowObject* GetUnshadowedNode(IArticyFlowObject* Node);
 
+	/** True while an exploration is running. */
+	bool bIsExploring = false;
+	/** The search tree of the running exploration, it is kept to reuse its memory. */
+	TArray<FArticyExploreNode> ExploreArena;
+	/** The index of the node in ExploreArena which is currently explored. */
+	int32 ExploreParent = INDEX_NONE;
+	/** Unshadowed nodes found during the running exploration, by id. */
+	TMap<FArticyId, IArticyFlowObject*> UnshadowedNodes;
+
+	/** Adds Node (unshadowed) to the search tree, as child of ExploreParent. */
+	int32 AddExploreNode(IArticyFlowObject* Node);
+	/** Builds the Path of all Branches from the search tree. */
+	void MaterializePaths(TArray<FArticyBranch>& Branches);
+
+	/** Same as Explore, but walks the precompiled flow graph. */
+	void ExploreGraph(const FArticyFlowGraphLocation& Location, bool bShadowed, int32 Depth, TArray<FArticyBranch>& OutBranches, bool IncludeCurrent = true);
+	/** Explores a node or pin of the flow graph, like IArticyFlowObject::Explore does for flow objects. */
+	void ExploreGraphNode(const FArticyFlowGraphLocation& Location, int32 Depth, TArray<FArticyBranch>& OutBranches);
+	/** Explores the output pins of a node in the flow graph, like IArticyOutputPinsProvider::Explore. */
+	void ExploreGraphOutputPins(const FArticyFlowGraph& Graph, int32 NodeIndex, int32 PinDepth, TArray<FArticyBranch>& OutBranches);
+	/** Explores the target pin of a connection in the flow graph. */
+	void ExploreGraphConnection(const FArticyFlowGraph& Graph, int32 ConnectionIndex, bool bShadowed, int32 Depth, TArray<FArticyBranch>& OutBranches);
+	/** Finds the target pin of a connection, which might be in the flow graph of another package. */
+	bool ResolveGraphConnection(const FArticyFlowGraph& Graph, int32 ConnectionIndex, FArticyFlowGraphLocation& OutTarget) const;
+	/** Adds the node or pin of the flow graph to the search tree, as child of ExploreParent. */
+	int32 AddGraphExploreNode(const FArticyFlowGraphLocation& Location);
+	/** Returns the flow object of a node or pin in the flow graph, either the current shadow or the unshadowed one. */
+	IArticyFlowObject* GetGraphObject(const FArticyFlowGraphLocation& Location, bool bUnshadowed);
+	/** Same as ShouldPauseOn, for a node or pin of the flow graph. */
+	bool ShouldPauseOnGraph(const FArticyFlowGraphLocation& Location) const;
+	/** Returns true if the node or pin of the flow graph is the current cursor. */
+	bool IsGraphCursor(const FArticyFlowGraphLocation& Location) const;
+	/** Sets the current object and speaker and runs the script of a node or pin in the flow graph. */
+	bool RunGraphScript(const FArticyFlowGraphLocation& Location, bool bIsCondition);
+
 	UArticyDatabase* GetDB() const;
 	UArticyExpressoScripts* GetExpresso() const;
 };
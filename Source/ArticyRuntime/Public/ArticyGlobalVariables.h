@@ -13,6 +13,8 @@
 #endif
 #include "ShadowStateManager.h"
 #include "ArticyExpressoScripts.h"
+#include "ArticyGvStorage.h"
+#include "ArticyGvReadView.h"
 #include "ArticyGlobalVariables.generated.h"
 
 class UArticyAlternativeGlobalVariables;
@@ -27,8 +29,14 @@ class UArticyAlternativeGlobalVariables;
 	}										\
 	const T& Get() const					\
 	{										\
-		/*just return the value*/			\
-		return Value;						\
+		/*track and return the value*/		\
+		NotifyRead();						\
+		return GetValueRef();				\
+	}										\
+	const T& GetValueRef() const			\
+	{										\
+		/*return the value without tracking*/	\
+		return FlatSlot == INDEX_NONE ? Value : GetFlatValue<T>();	\
 	}										\
 	operator const T &() const				\
 	{										\
@@ -44,6 +52,7 @@ class UArticyBaseVariableSet;
 struct ExpressoType;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnGVChanged, UArticyVariable*, Variable);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnGVsChanged, const TArray<UArticyVariable*>&, Variables);
 
 /**
  * This struct stores a shadow copy that is restored once the given shadow
@@ -83,6 +92,35 @@ public:
 	const FName& GetFullName();
 };
 
+/**
+ * Refers to a global variable by name, like FArticyGvName, but only looks the variable up on first access.
+ * Afterwards the generated id of the variable is cached, which is the same for all global variable instances.
+ * Use this to access variables repeatedly, e.g. every frame.
+ */
+USTRUCT(BlueprintType)
+struct ARTICYRUNTIME_API FArticyGvHandle
+{
+	GENERATED_BODY()
+
+public:
+
+	FArticyGvHandle() = default;
+	FArticyGvHandle(const FArticyGvName& VariableName) : Name(VariableName) { }
+	/** Creates a handle from the id of a variable, see the generated GlobalVariablesId enum. */
+	explicit FArticyGvHandle(const int32 VariableId) : Id(VariableId) { }
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Articy")
+	FArticyGvName Name;
+
+	/** Returns the id of the variable in the generated global variables, or INDEX_NONE if there is no such variable. */
+	int32 GetId(const UArticyGlobalVariables* Store) const;
+
+private:
+
+	/** The cached id of the variable, INDEX_NONE if not resolved yet. */
+	mutable int32 Id = INDEX_NONE;
+};
+
 UCLASS(Abstract, BlueprintType)
 class ARTICYRUNTIME_API UArticyVariable : public UObject
 {
@@ -99,9 +137,15 @@ public:
 	template<typename Type>
 	void Init(UArticyBaseVariableSet* Set, UArticyGlobalVariables* const NewStore, const FName& Name, const typename Type::UnderlyingType& NewValue);
 
+	/** Initializes this variable as a handle to a variable in the flat storage of NewStore. */
+	void InitFlat(UArticyBaseVariableSet* Set, UArticyGlobalVariables* const NewStore, const FName& Name, const int32 Slot);
+
 	/** Returns the name of this variable in the form Namespace.Variable */
 	const FName& GetGVName() const { return GVName; }
 
+	/** Returns a copy of the current value of this variable, without tracking it as a read. */
+	virtual ExpressoType GetExpressoValue() const { return ExpressoType{}; }
+
 protected:
 	virtual ~UArticyVariable() {}
 
@@ -113,6 +157,10 @@ protected:
 		auto Instance = static_cast<Type*>(this);
 		check(Instance);
 
+		//handles to variables in flat storage write the value in the store
+		if(FlatSlot != INDEX_NONE)
+			return SetFlatValue(NewValue);
+
 		//push the value if we are in a new shadow level now
 		const auto storeLevel = GetStoreShadowLevel();
 		const auto shadowLevel = GetShadowLevel(Instance);
@@ -131,7 +179,7 @@ protected:
 		
 		Instance->Value = NewValue;															
 		if(storeLevel == 0)
-			OnVariableChanged.Broadcast(this);
+			NotifyChanged();
 
 		return Instance->Value;
 	}																							
@@ -146,12 +194,29 @@ protected:
 	template<typename Type>
 	static uint32 GetShadowLevel(Type* Instance);
 	uint32 GetStoreShadowLevel() const;
+	/** Marks this variable as changed in the store, and broadcasts OnVariableChanged unless a change batch is active. */
+	void NotifyChanged();
+
+	/** Adds this variable to the reads tracked by its store, see UArticyGlobalVariables::TrackReads. */
+	void NotifyRead() const;
+
+	template<typename ValueType>
+	const ValueType& GetFlatValue() const;
+	template<typename ValueType>
+	ValueType& SetFlatValue(const ValueType& NewValue);
 
 	/** The name of this variable in the form Namespace.Variable */
 	UPROPERTY(BlueprintReadOnly, Category = "Articy")
 	FName GVName;
 
+	/** The slot of the variable in the store's flat storage, if this is only a handle to it. */
+	int32 FlatSlot = INDEX_NONE;
+
+	/** The generated id of the variable, once registered with the store. */
+	int32 Id = INDEX_NONE;
+
 private:
+	friend UArticyGlobalVariables;
 
 	UPROPERTY()
 	UArticyGlobalVariables* Store = nullptr;
@@ -169,8 +234,10 @@ class ARTICYRUNTIME_API UArticyInt : public UArticyVariable
 
 public:
 	typedef int UnderlyingType;
+	static constexpr EArticyGvType FlatType = EArticyGvType::Int;
 
 	friend UArticyVariable;
+	friend UArticyGlobalVariables;
 
 public:
 	//void Init(UArticyBaseGlobalVariables* const NewStore, const int& NewValue) { UArticyVariable::Init(NewStore); Set(NewValue); }
@@ -179,65 +246,65 @@ public:
 	ARTICY_VARIABLE_ACCESS(int)
 
 	//other operators
-	int& operator+=(const int &Val) { return *this = Value + Val; }
-	int& operator-=(const int &Val) { return *this = Value - Val; }
-	int& operator*=(const int &Val) { return *this = Value * Val; }
-	int& operator/=(const int &Val) { return *this = Value / Val; }
+	int& operator+=(const int &Val) { return *this = GetValueRef() + Val; }
+	int& operator-=(const int &Val) { return *this = GetValueRef() - Val; }
+	int& operator*=(const int &Val) { return *this = GetValueRef() * Val; }
+	int& operator/=(const int &Val) { return *this = GetValueRef() / Val; }
 
 	int operator++(int)
 	{
 		int copy = *this;
-		*this = Value + 1;
+		*this = GetValueRef() + 1;
 		return copy;
 	}
-	int& operator++() { return *this = Value + 1; }
+	int& operator++() { return *this = GetValueRef() + 1; }
 
 	int operator--(int)
 	{
 		int copy = *this;
-		*this = Value - 1;
+		*this = GetValueRef() - 1;
 		return copy;
 	}
-	int& operator--() { return *this = Value - 1; }
+	int& operator--() { return *this = GetValueRef() - 1; }
 
 	int& operator=(const ExpressoType &NewVal)
 	{
 		if (NewVal.Type == ExpressoType::Float)
-			return Value = NewVal.GetFloat();
+			return *this = static_cast<int>(NewVal.GetFloat());
 		else
-			return Value = NewVal.GetInt();
+			return *this = static_cast<int>(NewVal.GetInt());
 	}
 
 	int& operator+=(const ExpressoType &Val)
 	{
 		if (Val.Type == ExpressoType::Float)
-			return *this = Value + Val.GetFloat();
+			return *this = GetValueRef() + Val.GetFloat();
 		else
-			return *this = Value + Val.GetInt();
+			return *this = GetValueRef() + Val.GetInt();
 	}
 
 	int& operator-=(const ExpressoType &Val)
 	{
 		if (Val.Type == ExpressoType::Float)
-			return *this = Value - Val.GetFloat();
+			return *this = GetValueRef() - Val.GetFloat();
 		else
-			return *this = Value - Val.GetInt();
+			return *this = GetValueRef() - Val.GetInt();
 	}
 
 	int& operator*=(const ExpressoType &Val)
 	{
 		if (Val.Type == ExpressoType::Float)
-			return *this = Value * Val.GetFloat();
+			return *this = GetValueRef() * Val.GetFloat();
 		else
-			return *this = Value * Val.GetInt();
+			return *this = GetValueRef() * Val.GetInt();
 	}
 
 	int& operator/=(const ExpressoType &Val)
 	{
 		if (Val.Type == ExpressoType::Float)
-			return *this = Value / Val.GetFloat();
+			return *this = GetValueRef() / Val.GetFloat();
 		else
-			return *this = Value / Val.GetInt();
+			return *this = GetValueRef() / Val.GetInt();
 	}
 
 	/**
@@ -247,6 +314,8 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "ValueAccess")
 	int Set(int NewValue) { return *this = NewValue; }
 
+	ExpressoType GetExpressoValue() const override { return ExpressoType(GetValueRef()); }
+
 protected:
 	/** The current value of this variable (i.e. the value of a shadow state, if any is active). */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Articy")
@@ -321,8 +390,10 @@ class ARTICYRUNTIME_API UArticyBool : public UArticyVariable
 
 public:
 	typedef bool UnderlyingType;
+	static constexpr EArticyGvType FlatType = EArticyGvType::Bool;
 
 	friend UArticyVariable;
+	friend UArticyGlobalVariables;
 
 	//void Init(UArticyBaseGlobalVariables* const NewStore, const bool& NewValue) { UArticyVariable::Init(NewStore); Set(NewValue); }
 
@@ -331,7 +402,7 @@ public:
 
 	bool& operator=(const ExpressoType &NewValue)
 	{
-		return Value = NewValue.GetBool();
+		return *this = NewValue.GetBool();
 	}
 
 	/**
@@ -341,6 +412,8 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "ValueAccess")
 	bool Set(bool NewValue) { return *this = NewValue; }
 
+	ExpressoType GetExpressoValue() const override { return ExpressoType(GetValueRef()); }
+
 protected:
 
 	/** The current value of this variable (i.e. the value of a shadow state, if any is active). */
@@ -360,8 +433,10 @@ class ARTICYRUNTIME_API UArticyString : public UArticyVariable
 
 public:
 	typedef FString UnderlyingType;
+	static constexpr EArticyGvType FlatType = EArticyGvType::String;
 
 	friend UArticyVariable;
+	friend UArticyGlobalVariables;
 
 	//void Init(UArticyBaseGlobalVariables* const NewStore, const FString& NewValue) { UArticyVariable::Init(NewStore); Set(NewValue); }
 
@@ -371,21 +446,21 @@ public:
 	//other operators
 	//FString& operator+=(const FString &Val) { return Setter<UArticyString>(Value + Val); }
 
-	FString& operator+=(const ExpressoType &Val) { return Setter<UArticyString>(Value + Val.GetString()); }
+	FString& operator+=(const ExpressoType &Val) { return Setter<UArticyString>(GetValueRef() + Val.GetString()); }
 
 	FString& operator=(const ExpressoType &NewValue)
 	{
 		if (NewValue.Type == ExpressoType::Int) // used to store a string representation of an articy object
-			return Value = ArticyHelpers::Uint64ToObjectString(NewValue.GetInt());
+			return *this = ArticyHelpers::Uint64ToObjectString(NewValue.GetInt());
 		else
-			return Value = NewValue.GetString();
+			return *this = NewValue.GetString();
 	}
 
-	bool operator ==(const FString& text) const { return Value.Equals(text); }
+	bool operator ==(const FString& text) const { return Get().Equals(text); }
 	bool operator !=(const FString& text) const { return !this->operator==(text); }
-	bool operator ==(const FString&& text) const { return Value.Equals(text); }
+	bool operator ==(const FString&& text) const { return Get().Equals(text); }
 	bool operator !=(const FString&& text) const { return !this->operator==(text); }
-	bool operator ==(const char* const text) const { return Value.Equals(text); }
+	bool operator ==(const char* const text) const { return Get().Equals(text); }
 	bool operator !=(const char* const text) const { return !this->operator==(text); }
 
 	/**
@@ -395,6 +470,8 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "ValueAccess")
 	FString Set(FString NewValue) { return *this = NewValue; }
 
+	ExpressoType GetExpressoValue() const override { return ExpressoType(GetValueRef()); }
+
 protected:
 	/** The current value of this variable (i.e. the value of a shadow state, if any is active). */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Articy")
@@ -422,21 +499,19 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Callback")
 	FOnGVChanged OnVariableChanged;
 
+	/** Returns all variables of this namespace. For variables in flat storage, the handles are created on first use. */
 	UFUNCTION(BlueprintCallable, Category = "ArticyGlobalVariables", meta = (keywords = "global variables"))
-	const TArray<UArticyVariable*> GetVariables() const { return Variables; }
+	const TArray<UArticyVariable*> GetVariables() const;
 	
 	UFUNCTION(BlueprintCallable, Category = "ArticyGlobalVariables", meta =(DeterminesOutputType = "Type", keywords = "global variables"))
 	const TArray<UArticyVariable*> GetVariablesOfType(TSubclassOf<UArticyVariable> Type)
 	{
-		TArray<UObject*> subobjects;
-		GetDefaultSubobjects(subobjects);
 		TArray<UArticyVariable*> articyVars;
-		for (int i = 0; i < subobjects.Num(); i++)
+		for (UArticyVariable* Var : GetVariables())
 		{
-			const bool bIsA = subobjects[i]->IsA(Type);
+			const bool bIsA = Var->IsA(Type);
 			if (bIsA)
 			{
-				UArticyVariable* Var = Cast<UArticyVariable>(subobjects[i]);
 				articyVars.Add(Var);
 			}
 		}
@@ -447,12 +522,10 @@ public:
 	template<class T>
 	const TArray<T*> GetVariables()
 	{
-		TArray<UObject*> subobjects;
-		GetDefaultSubobjects(subobjects);
 		TArray<T*> articyVars;
-		for (int i = 0; i < subobjects.Num(); i++)
+		for (UArticyVariable* Var : GetVariables())
 		{
-			T* isT = Cast<T>(subobjects[i]);
+			T* isT = Cast<T>(Var);
 			if (isT != nullptr)
 			{
 				articyVars.Add(isT);
@@ -460,14 +533,28 @@ public:
 		}
 		return articyVars;
 	}
+
+	/** Returns the variable with the given name (without namespace), or nullptr if there is none. */
+	UArticyVariable* FindVariable(const FName Variable);
+
+	/** Adds a variable of this namespace to the flat storage of Store, returns its slot. */
+	template<typename ValueType>
+	int32 AddFlatVariable(UArticyGlobalVariables* const Store, const FName& Name, const ValueType& InitialValue);
 	
 private:
 
+	/** The store of the variables, if they are kept in its flat storage. */
+	UArticyGlobalVariables* FlatStore = nullptr;
+	/** The slots of the variables in flat storage. */
+	int32 FirstFlatSlot = INDEX_NONE;
+	int32 NumFlatSlots = 0;
+
 	UFUNCTION()
 	void BroadcastOnVariableChanged(UArticyVariable* Variable);
 
 	template <typename Type>
 	friend void UArticyVariable::Init(UArticyBaseVariableSet* Set, UArticyGlobalVariables* const NewStore, const FName& Name, const typename Type::UnderlyingType& NewValue);
+	friend UArticyVariable;
 };
 
 /**
@@ -526,11 +613,135 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Setter")
 	void SetStringVariable(FArticyGvName GvName, const FString Value);
 
+	UFUNCTION(BlueprintCallable, Category="Getter")
+	const bool& GetBoolVariableByHandle(const FArticyGvHandle& Handle, bool& bSucceeded);
+	UFUNCTION(BlueprintCallable, Category="Getter")
+	const int32& GetIntVariableByHandle(const FArticyGvHandle& Handle, bool& bSucceeded);
+	UFUNCTION(BlueprintCallable, Category="Getter")
+	const FString& GetStringVariableByHandle(const FArticyGvHandle& Handle, bool& bSucceeded);
+
+	UFUNCTION(BlueprintCallable, Category="Setter")
+	void SetBoolVariableByHandle(const FArticyGvHandle& Handle, const bool Value);
+	UFUNCTION(BlueprintCallable, Category="Setter")
+	void SetIntVariableByHandle(const FArticyGvHandle& Handle, const int32 Value);
+	UFUNCTION(BlueprintCallable, Category="Setter")
+	void SetStringVariableByHandle(const FArticyGvHandle& Handle, const FString Value);
+
+	/** Returns the id of a variable, i.e. its index in the generated global variables, or INDEX_NONE. */
+	int32 FindVariableId(FArticyGvName GvName) const;
+	/** Returns the variable with the given id, or nullptr. Creates the handle if the variable is in flat storage. */
+	UArticyVariable* GetVariableById(const int32 Id);
+	int32 GetNumVariables() const { return UsesFlatStorage() ? FlatStorage.Num() : VariablesById.Num(); }
+
+	/**
+	 * Writes the values of all variables into a compact, versioned binary snapshot, e.g. for save games.
+	 * The snapshot can only be restored by global variables generated from the same set of variables.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Snapshot")
+	TArray<uint8> CaptureSnapshot() const;
+
+	/**
+	 * Restores the values of all variables from a snapshot created by CaptureSnapshot, without creating any objects.
+	 * OnVariableChanged is only broadcast (for the variables that actually changed) if bNotifyChanges is set.
+	 * Returns false if the snapshot is invalid, was captured from a different set of variables,
+	 * or if the variables are in a shadow state (e.g. during flow player exploration).
+	 */
+	UFUNCTION(BlueprintCallable, Category="Snapshot")
+	bool RestoreSnapshot(const TArray<uint8>& Snapshot, bool bNotifyChanges = false);
+
+	/**
+	 * Writes the ids and values of all variables which changed since the last call with bClearDirty set
+	 * (or ClearDirtyVariables), i.e. the delta to the state at that time. Only changes outside of shadow states count.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Snapshot")
+	TArray<uint8> CaptureDelta(bool bClearDirty = true);
+
+	/** Writes the ids and values of all variables which differ from the given snapshot. Returns an empty array if the snapshot is invalid. */
+	UFUNCTION(BlueprintCallable, Category="Snapshot")
+	TArray<uint8> CaptureDeltaFromSnapshot(const TArray<uint8>& BaseSnapshot) const;
+
+	/**
+	 * Applies a delta created by CaptureDelta or CaptureDeltaFromSnapshot, without creating any objects.
+	 * OnVariableChanged is only broadcast (for the variables that actually changed) if bNotifyChanges is set.
+	 * Returns false if the delta is invalid, was captured from a different set of variables,
+	 * or if the variables are in a shadow state.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Snapshot")
+	bool ApplyDelta(const TArray<uint8>& Delta, bool bNotifyChanges = true);
+
+	/** Forgets which variables changed, see CaptureDelta. */
+	UFUNCTION(BlueprintCallable, Category="Snapshot")
+	void ClearDirtyVariables();
+
+	/**
+	 * Publishes a copy of the current values, which other threads can read via GetReadViews, if anything changed
+	 * since the last publication. Call this on the game thread whenever worker threads should see the changes, e.g. once per frame.
+	 * Logs an error and publishes nothing while in a shadow state.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Threading")
+	void PublishReadView();
+
+	/**
+	 * The published copies of the values, which can be read from any thread with an FArticyGvReadViews::FReadScope.
+	 * The global variables object must be kept alive while reading.
+	 */
+	const FArticyGvReadViews& GetReadViews() const { return ReadViews; }
+
+	virtual void BeginDestroy() override;
+
 	UFUNCTION(BlueprintCallable, Category="Debug")
 	void EnableDebugLogging();
 	UFUNCTION(BlueprintCallable, Category="Debug")
 	void DisableDebugLogging();
 
+	/**
+	 * This delegate is broadcast with all variables that changed, once per change batch (see FArticyGvChangeBatch),
+	 * or once per change if no batch is active. Changes in shadow states are not included.
+	 */
+	UPROPERTY(BlueprintAssignable, Category = "Callback")
+	FOnGVsChanged OnVariablesChanged;
+
+	/**
+	 * Starts coalescing change notifications. Until the matching EndChangeBatch, OnVariableChanged is not broadcast.
+	 * Then it is broadcast once for each changed variable, followed by OnVariablesChanged. Batches can be nested.
+	 * An EndChangeBatch without matching BeginChangeBatch logs an error and does nothing.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Callback")
+	void BeginChangeBatch();
+	UFUNCTION(BlueprintCallable, Category = "Callback")
+	void EndChangeBatch();
+
+	/**
+	 * True if the generated global variables keep their values in flat storage,
+	 * instead of one UArticyVariable object per variable.
+	 */
+	virtual bool UsesFlatStorage() const { return false; }
+
+	const FArticyGvStorage& GetFlatStorage() const { return FlatStorage; }
+
+	/** Returns the handle of a variable in flat storage, which is created on first use. */
+	UArticyVariable* GetVariableHandle(const int32 Slot);
+
+	/** Sets the value of a variable in flat storage, respecting the current shadow state. */
+	template<typename ValueType>
+	ValueType& SetFlatValue(const int32 Slot, const ValueType& NewValue);
+
+	/**
+	 * Starts collecting all variables of this store that are read (via Get) into Reads, until this is called again.
+	 * Returns the previously active set, so nested trackings can be restored. Pass nullptr to stop tracking.
+	 * Reads of other stores are not tracked.
+	 */
+	TSet<const UArticyVariable*>* TrackReads(TSet<const UArticyVariable*>* Reads);
+
+	/** Tracks the read of a variable in flat storage, see TrackReads. */
+	void NotifyFlatRead(const int32 Slot)
+	{
+		if(ReadTracker)
+			ReadTracker->Add(GetVariableHandle(Slot));
+	}
+
+	virtual void Serialize(FArchive& Ar) override;
+
 protected:
 
 	UPROPERTY()
@@ -539,8 +750,76 @@ protected:
 	UPROPERTY()
 	bool bLogVariableAccess = false;
 
+	/** The values of all variables, if UsesFlatStorage is true. Filled by the generated namespaces. */
+	FArticyGvStorage FlatStorage;
+
+	friend UArticyBaseVariableSet;
+
 private:
 
+	/** All variables (if not in flat storage), by id. They are kept alive by their namespaces. */
+	TArray<UArticyVariable*> VariablesById;
+	TMap<FName, int32> VariableIds;
+
+	void RegisterVariable(UArticyVariable* Variable);
+
+	/** Returns the type of the variable with the given id. */
+	EArticyGvType GetVariableType(const int32 Id) const;
+	/** Returns a hash of the names and types of all variables, which identifies the layout of a snapshot. */
+	uint32 GetLayoutHash() const;
+	mutable TOptional<uint32> LayoutHash;
+
+	/** Reads the value of a variable without tracking the read. */
+	template<typename VariableType>
+	const typename VariableType::UnderlyingType& PeekValue(const int32 Id) const;
+	/** Writes the value of a variable without shadowing or notification, returns true if the value changed. */
+	template<typename VariableType>
+	bool PokeValue(const int32 Id, const typename VariableType::UnderlyingType& NewValue);
+
+	void BroadcastValueChanged(const int32 Id);
+
+	/** Marks a variable as changed, and broadcasts its change unless a change batch is active. */
+	void NotifyValueChanged(const int32 Id);
+
+	/** The number of active change batches. */
+	int32 ChangeBatchDepth = 0;
+	/** The ids of the variables which changed in the active change batch, in order of their first change. */
+	TArray<int32> BatchedChanges;
+	TBitArray<> BatchedChangesMask;
+
+	/** The set of variables which are currently tracked, see TrackReads. */
+	TSet<const UArticyVariable*>* ReadTracker = nullptr;
+
+	/** The ids of the variables which changed (at shadow level 0) since the last delta. */
+	TBitArray<> DirtyVariables;
+	void MarkDirty(const int32 Id);
+
+	/** Counts all changes at shadow level 0, to skip publishing unchanged read views. */
+	uint64 ChangeCount = 0;
+	uint64 PublishedChangeCount = 0;
+
+	FArticyGvReadViews ReadViews;
+	TSharedPtr<const FArticyGvReadViewLayout, ESPMode::ThreadSafe> ReadViewLayout;
+
+	/** The values of a decoded snapshot, per type in id order. */
+	struct FDecodedSnapshot
+	{
+		TArray<bool> Bools;
+		TArray<int32> Ints;
+		TArray<FString> Strings;
+	};
+
+	void WriteSnapshotHeader(TArray<uint8>& Buffer, const uint8 Version, const uint32 Count) const;
+	bool ReadSnapshotHeader(const TArray<uint8>& Buffer, int32& Offset, const uint8 Version, uint32& OutCount) const;
+	bool DecodeSnapshot(const TArray<uint8>& Snapshot, FDecodedSnapshot& OutValues) const;
+	void WriteDeltaValue(TArray<uint8>& Buffer, const int32 Id) const;
+
+	/** The handles to the variables in flat storage, by slot. */
+	UPROPERTY(Transient, DuplicateTransient)
+	TArray<UArticyVariable*> FlatHandles;
+
+	void BroadcastFlatValueChanged(const int32 Slot);
+
 	static TWeakObjectPtr<UArticyGlobalVariables> Clone;
 
 	// Runtime clones of non-default global variable assets managed by GetRuntimeClone
@@ -555,6 +834,199 @@ private:
 	const VariablePayloadType& GetVariableValue(const FName Namespace, const FName Variable, bool& bSucceeded);
 	template<typename ArticyVariableType, typename VariablePayloadType>
 	const VariablePayloadType& GetVariableValue(const FName FullVariableName, bool& bSucceeded);
+
+	template<typename ArticyVariableType, typename VariablePayloadType>
+	void SetVariableValue(const FArticyGvHandle& Handle, const VariablePayloadType& Value);
+	template<typename ArticyVariableType, typename VariablePayloadType>
+	const VariablePayloadType& GetVariableValue(const FArticyGvHandle& Handle, bool& bSucceeded);
+
+	friend UArticyVariable;
+};
+
+//---------------------------------------------------------------------------//
+
+/**
+ * Coalesces the change notifications of the global variables while in scope, see UArticyGlobalVariables::BeginChangeBatch.
+ */
+class ARTICYRUNTIME_API FArticyGvChangeBatch
+{
+public:
+	explicit FArticyGvChangeBatch(UArticyGlobalVariables* GlobalVariables) : Store(GlobalVariables)
+	{
+		if(Store)
+			Store->BeginChangeBatch();
+	}
+
+	~FArticyGvChangeBatch()
+	{
+		if(Store)
+			Store->EndChangeBatch();
+	}
+
+	FArticyGvChangeBatch(const FArticyGvChangeBatch&) = delete;
+	FArticyGvChangeBatch& operator=(const FArticyGvChangeBatch&) = delete;
+
+private:
+	UArticyGlobalVariables* Store;
+};
+
+//---------------------------------------------------------------------------//
+
+/**
+ * A variable in the flat storage of UArticyGlobalVariables, used by the generated namespaces instead of a
+ * UArticyVariable object. It provides the same accessors and operators, so the generated scripts work with both.
+ */
+template<typename T, typename Derived>
+class TArticyGvRef
+{
+public:
+	typedef T UnderlyingType;
+
+	void Init(UArticyBaseVariableSet* Set, UArticyGlobalVariables* const NewStore, const FName& Name, const T& InitialValue)
+	{
+		Store = NewStore;
+		Slot = Set->AddFlatVariable(NewStore, Name, InitialValue);
+	}
+
+	T& operator=(const T& NewValue) { return Store->SetFlatValue(Slot, NewValue); }
+	const T& Get() const
+	{
+		Store->NotifyFlatRead(Slot);
+		return GetValueRef();
+	}
+	const T& GetValueRef() const { return Store->GetFlatStorage().Get<T>(Slot); }
+	operator const T&() const { return Get(); }
+
+	T Set(T NewValue) { return *this = NewValue; }
+
+	/** The generated scripts dereference variables, as they are pointers to UArticyVariable objects otherwise. */
+	Derived& operator*() { return static_cast<Derived&>(*this); }
+	Derived* operator->() { return static_cast<Derived*>(this); }
+
+	/** Returns the handle of this variable, e.g. to pass it to Blueprints. */
+	UArticyVariable* GetVariable() const { return Store->GetVariableHandle(Slot); }
+	int32 GetSlot() const { return Slot; }
+
+protected:
+	UArticyGlobalVariables* Store = nullptr;
+	int32 Slot = INDEX_NONE;
+};
+
+class FArticyGvInt : public TArticyGvRef<int, FArticyGvInt>
+{
+public:
+	using TArticyGvRef::operator=;
+	int& operator=(const FArticyGvInt& Other) { return *this = Other.Get(); }
+
+	int& operator+=(const int &Val) { return *this = GetValueRef() + Val; }
+	int& operator-=(const int &Val) { return *this = GetValueRef() - Val; }
+	int& operator*=(const int &Val) { return *this = GetValueRef() * Val; }
+	int& operator/=(const int &Val) { return *this = GetValueRef() / Val; }
+
+	int operator++(int)
+	{
+		int copy = *this;
+		*this = GetValueRef() + 1;
+		return copy;
+	}
+	int& operator++() { return *this = GetValueRef() + 1; }
+
+	int operator--(int)
+	{
+		int copy = *this;
+		*this = GetValueRef() - 1;
+		return copy;
+	}
+	int& operator--() { return *this = GetValueRef() - 1; }
+
+	int& operator=(const ExpressoType &NewVal)
+	{
+		if (NewVal.Type == ExpressoType::Float)
+			return *this = static_cast<int>(NewVal.GetFloat());
+		else
+			return *this = static_cast<int>(NewVal.GetInt());
+	}
+
+	int& operator+=(const ExpressoType &Val)
+	{
+		if (Val.Type == ExpressoType::Float)
+			return *this = GetValueRef() + Val.GetFloat();
+		else
+			return *this = GetValueRef() + Val.GetInt();
+	}
+
+	int& operator-=(const ExpressoType &Val)
+	{
+		if (Val.Type == ExpressoType::Float)
+			return *this = GetValueRef() - Val.GetFloat();
+		else
+			return *this = GetValueRef() - Val.GetInt();
+	}
+
+	int& operator*=(const ExpressoType &Val)
+	{
+		if (Val.Type == ExpressoType::Float)
+			return *this = GetValueRef() * Val.GetFloat();
+		else
+			return *this = GetValueRef() * Val.GetInt();
+	}
+
+	int& operator/=(const ExpressoType &Val)
+	{
+		if (Val.Type == ExpressoType::Float)
+			return *this = GetValueRef() / Val.GetFloat();
+		else
+			return *this = GetValueRef() / Val.GetInt();
+	}
+};
+
+static int operator+(const FArticyGvInt& v1, const FArticyGvInt& v2) { return v1.Get() + v2.Get(); }
+static int operator+(int k, const FArticyGvInt& v) { return k + v.Get(); }
+static int operator+(const FArticyGvInt& v, int k) { return v.Get() + k; }
+static int operator-(const FArticyGvInt& v1, const FArticyGvInt& v2) { return v1.Get() - v2.Get(); }
+static int operator-(int k, const FArticyGvInt& v) { return k - v.Get(); }
+static int operator-(const FArticyGvInt& v, int k) { return v.Get() - k; }
+static int operator*(const FArticyGvInt& v1, const FArticyGvInt& v2) { return v1.Get() * v2.Get(); }
+static int operator*(int k, const FArticyGvInt& v) { return k * v.Get(); }
+static int operator*(const FArticyGvInt& v, int k) { return v.Get() * k; }
+static int operator/(const FArticyGvInt& v1, const FArticyGvInt& v2) { return v1.Get() / v2.Get(); }
+static int operator/(int k, const FArticyGvInt& v) { return k / v.Get(); }
+static int operator/(const FArticyGvInt& v, int k) { return v.Get() / k; }
+
+class FArticyGvBool : public TArticyGvRef<bool, FArticyGvBool>
+{
+public:
+	using TArticyGvRef::operator=;
+	bool& operator=(const FArticyGvBool& Other) { return *this = Other.Get(); }
+
+	bool& operator=(const ExpressoType &NewValue)
+	{
+		return *this = NewValue.GetBool();
+	}
+};
+
+class FArticyGvString : public TArticyGvRef<FString, FArticyGvString>
+{
+public:
+	using TArticyGvRef::operator=;
+	FString& operator=(const FArticyGvString& Other) { return *this = Other.Get(); }
+
+	FString& operator+=(const ExpressoType &Val) { return *this = GetValueRef() + Val.GetString(); }
+
+	FString& operator=(const ExpressoType &NewValue)
+	{
+		if (NewValue.Type == ExpressoType::Int) // used to store a string representation of an articy object
+			return *this = ArticyHelpers::Uint64ToObjectString(NewValue.GetInt());
+		else
+			return *this = NewValue.GetString();
+	}
+
+	bool operator ==(const FString& text) const { return Get().Equals(text); }
+	bool operator !=(const FString& text) const { return !this->operator==(text); }
+	bool operator ==(const FString&& text) const { return Get().Equals(text); }
+	bool operator !=(const FString&& text) const { return !this->operator==(text); }
+	bool operator ==(const char* const text) const { return Get().Equals(text); }
+	bool operator !=(const char* const text) const { return !this->operator==(text); }
 };
 
 //---------------------------------------------------------------------------//
@@ -573,10 +1045,31 @@ void UArticyVariable::Init(UArticyBaseVariableSet* Set, UArticyGlobalVariables*
 	//set the initial value
 	Setter<Type>(NewValue);
 
+	//the variables are initialized in the order of their generated ids
+	Store->RegisterVariable(this);
+
 	//register the set's OnVariableChanged delegate on the variable's
 	OnVariableChanged.AddDynamic(Set, &UArticyBaseVariableSet::BroadcastOnVariableChanged);
 }
 
+inline void UArticyVariable::NotifyRead() const
+{
+	if(Store && Store->ReadTracker)
+		Store->ReadTracker->Add(this);
+}
+
+template <typename ValueType>
+const ValueType& UArticyVariable::GetFlatValue() const
+{
+	return Store->GetFlatStorage().Get<ValueType>(FlatSlot);
+}
+
+template <typename ValueType>
+ValueType& UArticyVariable::SetFlatValue(const ValueType& NewValue)
+{
+	return Store->SetFlatValue(FlatSlot, NewValue);
+}
+
 template <typename Type>
 uint32 UArticyVariable::GetShadowLevel(Type* Instance)
 {
@@ -586,11 +1079,49 @@ uint32 UArticyVariable::GetShadowLevel(Type* Instance)
 template <typename Type>
 void UArticyVariable::RegisterOnStorePop(Type* Instance)
 {
-#if __cplusplus >= 202002L
-	Store->RegisterOnPopState([=, this] { this->PopState(Instance); });
-#else
-	Store->RegisterOnPopState([=] { this->PopState(Instance); });
-#endif
+	Store->AddToUndoLog(Instance, [](void* Target)
+	{
+		auto Variable = static_cast<Type*>(Target);
+		Variable->PopState(Variable);
+	});
+}
+
+template <typename ValueType>
+int32 UArticyBaseVariableSet::AddFlatVariable(UArticyGlobalVariables* const Store, const FName& Name, const ValueType& InitialValue)
+{
+	const int32 Slot = Store->FlatStorage.AddVariable(this, Name, InitialValue);
+
+	//the variables of a namespace are added one after the other
+	if(FirstFlatSlot == INDEX_NONE)
+		FirstFlatSlot = Slot;
+	ensure(FirstFlatSlot + NumFlatSlots == Slot);
+	++NumFlatSlots;
+
+	FlatStore = Store;
+	return Slot;
+}
+
+template <typename ValueType>
+ValueType& UArticyGlobalVariables::SetFlatValue(const int32 Slot, const ValueType& NewValue)
+{
+	const uint32 Level = GetShadowLevel();
+
+	bool bNewShadowLevel = false;
+	auto& Value = FlatStorage.Set(Slot, NewValue, Level, bNewShadowLevel);
+
+	//get notified when the state is popped again
+	if(bNewShadowLevel)
+	{
+		AddToUndoLog(this, [](void* Target)
+		{
+			static_cast<UArticyGlobalVariables*>(Target)->FlatStorage.PopShadowLevel();
+		});
+	}
+
+	if(Level == 0)
+		NotifyValueChanged(Slot);
+
+	return Value;
 }
 
 template <typename ArticyVariableType, typename VariablePayloadType>
@@ -599,11 +1130,11 @@ void UArticyGlobalVariables::SetVariableValue(const FName Namespace, const FName
 	auto set = GetNamespace(Namespace);
 	if (set)
 	{
-		UArticyVariable** basePtr = set->GetPropPtr<UArticyVariable*>(Variable);
+		UArticyVariable* baseVariable = set->FindVariable(Variable);
 
-		if (basePtr) {
+		if (baseVariable) {
 		
-			ArticyVariableType* typedPtr = dynamic_cast<ArticyVariableType*>(*basePtr);
+			ArticyVariableType* typedPtr = dynamic_cast<ArticyVariableType*>(baseVariable);
 			if (typedPtr)
 			{
 				auto& propValue = (*typedPtr);
@@ -631,9 +1162,9 @@ const VariablePayloadType& UArticyGlobalVariables::GetVariableValue(const FName
 	auto set = GetNamespace(Namespace);
 	if (set)
 	{
-		UArticyVariable** basePtr = set->GetPropPtr<UArticyVariable*>(Variable);
+		UArticyVariable* baseVariable = set->FindVariable(Variable);
 
-		ArticyVariableType* typedPtr = dynamic_cast<ArticyVariableType*>(*basePtr);
+		ArticyVariableType* typedPtr = dynamic_cast<ArticyVariableType*>(baseVariable);
 
 		if (typedPtr)
 		{
@@ -658,3 +1189,63 @@ const VariablePayloadType& UArticyGlobalVariables::GetVariableValue(const FName
 	static VariablePayloadType empty = VariablePayloadType();
 	return empty;
 }
+
+template<typename ArticyVariableType, typename VariablePayloadType>
+void UArticyGlobalVariables::SetVariableValue(const FArticyGvHandle& Handle, const VariablePayloadType& Value)
+{
+	const int32 Id = Handle.GetId(this);
+	if(Id != INDEX_NONE)
+	{
+		if(UsesFlatStorage())
+		{
+			if(FlatStorage.GetSlot(Id).Type == ArticyVariableType::FlatType)
+			{
+				SetFlatValue(Id, Value);
+				return;
+			}
+		}
+		else if(ArticyVariableType* typedPtr = Cast<ArticyVariableType>(VariablesById[Id]))
+		{
+			auto& propValue = (*typedPtr);
+			propValue = Value;
+			return;
+		}
+	}
+
+	if (bLogVariableAccess)
+	{
+		UE_LOG(LogArticyRuntime, Error, TEXT("Unable to find variable: %s. Variable does not exist or wrong type assumed."), *Handle.Name.FullName.ToString());
+	}
+}
+
+template<typename ArticyVariableType, typename VariablePayloadType>
+const VariablePayloadType& UArticyGlobalVariables::GetVariableValue(const FArticyGvHandle& Handle, bool& bSucceeded)
+{
+	const int32 Id = Handle.GetId(this);
+	if(Id != INDEX_NONE)
+	{
+		if(UsesFlatStorage())
+		{
+			if(FlatStorage.GetSlot(Id).Type == ArticyVariableType::FlatType)
+			{
+				bSucceeded = true;
+				NotifyFlatRead(Id);
+				return FlatStorage.Get<VariablePayloadType>(Id);
+			}
+		}
+		else if(ArticyVariableType* typedPtr = Cast<ArticyVariableType>(VariablesById[Id]))
+		{
+			bSucceeded = true;
+			return typedPtr->Get();
+		}
+	}
+
+	if(bLogVariableAccess)
+	{
+		UE_LOG(LogArticyRuntime, Error, TEXT("Unable to find variable: %s"), *Handle.Name.FullName.ToString());
+	}
+
+	bSucceeded = false;
+	static VariablePayloadType empty = VariablePayloadType();
+	return empty;
+}
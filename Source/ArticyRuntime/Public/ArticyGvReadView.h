@@ -0,0 +1,106 @@
+//  
+// Copyright (c) 2023 articy Software GmbH & Co. KG. All rights reserved.  
+//
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ArticyGvStorage.h"
+#include <atomic>
+
+/** Where the value of each variable is found in FArticyGvReadView, shared by all views of the same global variables. */
+struct FArticyGvReadViewLayout
+{
+	/** The type of each variable, by id. */
+	TArray<EArticyGvType> Types;
+	/** The index of each variable in the array of its type, by id. */
+	TArray<int32> Indices;
+	/** The id of each variable, by name (Namespace.Variable). */
+	TMap<FName, int32> Ids;
+};
+
+/**
+ * An immutable copy of the values of all global variables, which can be read from any thread.
+ * Variables are addressed by their generated id, see the generated GlobalVariablesId enum.
+ */
+struct ARTICYRUNTIME_API FArticyGvReadView
+{
+	/** Increases with every published view of the same global variables. */
+	uint64 Version = 0;
+
+	TSharedPtr<const FArticyGvReadViewLayout, ESPMode::ThreadSafe> Layout;
+	TArray<bool> Bools;
+	TArray<int32> Ints;
+	TArray<FString> Strings;
+
+	/** Returns the id of the variable with the given name (Namespace.Variable), or INDEX_NONE. */
+	int32 FindId(const FName& FullName) const;
+
+	bool GetBool(const int32 Id, bool& OutValue) const;
+	bool GetInt(const int32 Id, int32& OutValue) const;
+	bool GetString(const int32 Id, FString& OutValue) const;
+
+private:
+	template<typename T>
+	bool GetValue(const int32 Id, const EArticyGvType Type, const TArray<T>& Values, T& OutValue) const;
+};
+
+/**
+ * Publishes read views of global variables from the game thread, and lets any thread read the latest one without locks.
+ *
+ * Readers enter an epoch for the duration of an FReadScope. A replaced view is only deleted once no reader
+ * is left in an epoch which could have seen it, so the view of a scope stays valid until the scope ends.
+ */
+class ARTICYRUNTIME_API FArticyGvReadViews
+{
+public:
+	FArticyGvReadViews() = default;
+	~FArticyGvReadViews();
+
+	FArticyGvReadViews(const FArticyGvReadViews&) = delete;
+	FArticyGvReadViews& operator=(const FArticyGvReadViews&) = delete;
+
+	/** Makes View the latest view. Must only be called from one thread (the game thread). */
+	void Publish(TUniquePtr<FArticyGvReadView> View);
+
+	/** Returns the latest published view without entering a read scope. Only safe on the publishing thread. */
+	const FArticyGvReadView* GetLatest() const { return Latest.load(); }
+
+	/** Waits for all readers to leave, then deletes all views. Must be called on the publishing thread. */
+	void Reset();
+
+	/**
+	 * Keeps the latest view (at the time the scope starts) alive while in scope. Keep scopes short,
+	 * as views replaced in the meantime cannot be deleted until the scope ends.
+	 */
+	class ARTICYRUNTIME_API FReadScope
+	{
+	public:
+		explicit FReadScope(const FArticyGvReadViews& Views);
+		~FReadScope();
+
+		FReadScope(const FReadScope&) = delete;
+		FReadScope& operator=(const FReadScope&) = delete;
+
+		/** The view of this scope, or nullptr if none was published yet. */
+		const FArticyGvReadView* Get() const { return View; }
+		const FArticyGvReadView* operator->() const { return View; }
+
+	private:
+		const FArticyGvReadViews& Views;
+		uint64 Epoch;
+		const FArticyGvReadView* View;
+	};
+
+private:
+	std::atomic<const FArticyGvReadView*> Latest { nullptr };
+
+	/** The current epoch, readers register in the counter of its parity. */
+	mutable std::atomic<uint64> Epoch { 0 };
+	mutable std::atomic<int32> Readers[2] = { { 0 }, { 0 } };
+
+	/** The views replaced while the epoch of the same parity was current. Only accessed by the publishing thread. */
+	TArray<const FArticyGvReadView*> Retired[2];
+
+	void DeleteRetired(const int32 Parity);
+};
@@ -0,0 +1,133 @@
+//  
+// Copyright (c) 2023 articy Software GmbH & Co. KG. All rights reserved.  
+//
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UArticyBaseVariableSet;
+
+enum class EArticyGvType : uint8
+{
+	Bool,
+	Int,
+	String
+};
+
+/** Where a global variable lives in FArticyGvStorage. */
+struct FArticyGvSlot
+{
+	/** The name of the variable in the form Namespace.Variable */
+	FName Name;
+	EArticyGvType Type = EArticyGvType::Bool;
+	/** The index of the value in the array of the variable's type. */
+	int32 Index = INDEX_NONE;
+	/** The namespace the variable belongs to. */
+	UArticyBaseVariableSet* Set = nullptr;
+};
+
+/**
+ * Keeps the values of all global variables in one contiguous array per type, instead of one UObject per variable.
+ * A variable is addressed by its slot, which is assigned in the order the generated namespaces add their variables.
+ * Shadow states are kept as a log of old values, which is rolled back one shadow level at a time.
+ */
+struct ARTICYRUNTIME_API FArticyGvStorage
+{
+public:
+	int32 AddVariable(UArticyBaseVariableSet* Set, const FName& Name, const bool& InitialValue);
+	int32 AddVariable(UArticyBaseVariableSet* Set, const FName& Name, const int32& InitialValue);
+	int32 AddVariable(UArticyBaseVariableSet* Set, const FName& Name, const FString& InitialValue);
+
+	/** Returns the slot of the variable with the given name (Namespace.Variable), or INDEX_NONE. */
+	int32 FindSlot(const FName& FullName) const;
+
+	int32 Num() const { return Slots.Num(); }
+	const FArticyGvSlot& GetSlot(const int32 Slot) const { return Slots[Slot]; }
+
+	template<typename T>
+	const T& Get(const int32 Slot) const { return Values(static_cast<T*>(nullptr))[Slots[Slot].Index]; }
+
+	/**
+	 * Sets and returns the value of a variable. If ShadowLevel is above zero, the old value is logged first.
+	 * bNewShadowLevel is set if this was the first change in ShadowLevel, in which case the caller has to
+	 * call PopShadowLevel once the shadow state is popped.
+	 */
+	template<typename T>
+	T& Set(const int32 Slot, const T& NewValue, const uint32 ShadowLevel, bool& bNewShadowLevel);
+
+	/** Restores the old values logged in the topmost shadow level. */
+	void PopShadowLevel();
+
+	/** Serializes the current values. The slots are not serialized, they are always added by the generated code. */
+	void SerializeValues(FArchive& Ar);
+
+private:
+	/** Bools are not packed into bits, so they can be handed out by reference like the other types. */
+	TArray<bool> Bools;
+	TArray<int32> Ints;
+	TArray<FString> Strings;
+
+	TArray<FArticyGvSlot> Slots;
+	TMap<FName, int32> SlotsByName;
+
+	template<typename T>
+	struct TUndoEntry
+	{
+		int32 Index;
+		T OldValue;
+	};
+
+	TArray<TUndoEntry<bool>> BoolUndoLog;
+	TArray<TUndoEntry<int32>> IntUndoLog;
+	TArray<TUndoEntry<FString>> StringUndoLog;
+
+	struct FUndoLogStart
+	{
+		uint32 ShadowLevel;
+		int32 Bools;
+		int32 Ints;
+		int32 Strings;
+	};
+
+	/** Where the undo logs of each shadow level with changes start. */
+	TArray<FUndoLogStart> UndoLogStarts;
+
+	TArray<bool>& Values(bool*) { return Bools; }
+	TArray<int32>& Values(int32*) { return Ints; }
+	TArray<FString>& Values(FString*) { return Strings; }
+	const TArray<bool>& Values(bool*) const { return Bools; }
+	const TArray<int32>& Values(int32*) const { return Ints; }
+	const TArray<FString>& Values(FString*) const { return Strings; }
+
+	TArray<TUndoEntry<bool>>& UndoLog(bool*) { return BoolUndoLog; }
+	TArray<TUndoEntry<int32>>& UndoLog(int32*) { return IntUndoLog; }
+	TArray<TUndoEntry<FString>>& UndoLog(FString*) { return StringUndoLog; }
+
+	template<typename T>
+	int32 Add(UArticyBaseVariableSet* Set, const FName& Name, const EArticyGvType Type, const T& InitialValue);
+
+	template<typename T>
+	static void Rollback(TArray<T>& Values, TArray<TUndoEntry<T>>& UndoLog, const int32 Start);
+};
+
+template<typename T>
+T& FArticyGvStorage::Set(const int32 Slot, const T& NewValue, const uint32 ShadowLevel, bool& bNewShadowLevel)
+{
+	auto& Value = Values(static_cast<T*>(nullptr))[Slots[Slot].Index];
+
+	bNewShadowLevel = false;
+	if(ShadowLevel > 0)
+	{
+		if(UndoLogStarts.Num() == 0 || UndoLogStarts.Last().ShadowLevel < ShadowLevel)
+		{
+			UndoLogStarts.Add({ ShadowLevel, BoolUndoLog.Num(), IntUndoLog.Num(), StringUndoLog.Num() });
+			bNewShadowLevel = true;
+		}
+
+		UndoLog(static_cast<T*>(nullptr)).Add({ Slots[Slot].Index, Value });
+	}
+
+	Value = NewValue;
+	return Value;
+}
@@ -6,6 +6,7 @@
 
 #include "CoreMinimal.h"
 #include "ArticyObject.h"
+#include "ArticyFlowGraph.h"
 #include "UObject/UObjectHash.h"
 #include "ArticyPackage.generated.h"
 
@@ -38,10 +39,10 @@ public:
 	void Clear();
 
 	UFUNCTION()
-	const TArray<UArticyObject*> GetAssets();
+	const TArray<UArticyObject*>& GetAssets() const;
 
 	UFUNCTION()
-	const TMap<FName, TSoftObjectPtr<UArticyObject>> GetAssetsDict();
+	const TMap<FName, TSoftObjectPtr<UArticyObject>>& GetAssetsDict() const;
 
 	UFUNCTION()
 	UArticyObject* GetAssetById(const FArticyId& Id) const;
@@ -60,6 +61,17 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Package")
 	bool bIsDefaultPackage = false;
 
+	/** Rebuilds the flow graph from the package's assets, called on import. */
+	void BuildFlowGraph() { FlowGraph.Build(Assets); }
+
+	const FArticyFlowGraph& GetFlowGraph() const { return FlowGraph; }
+
+protected:
+
+	/** The flow of all assets in this package, precompiled for exploration. */
+	UPROPERTY()
+	FArticyFlowGraph FlowGraph;
+
 private:
 	// used to determine which objects are still parented to this package, which may include outdated articy objects that have to be deleted
 	TArray<UObject*> GetInnerObjects() const;
@@ -72,17 +84,18 @@ inline const int UArticyPackage::AssetNum()const
 
 inline void UArticyPackage::Clear()
 {
+	FlowGraph = FArticyFlowGraph{};
 	Assets.Empty();
 	AssetsById.Empty();
 	AssetsByTechnicalName.Empty();
 }
 
-inline const TArray<UArticyObject*> UArticyPackage::GetAssets()
+inline const TArray<UArticyObject*>& UArticyPackage::GetAssets() const
 {
 	return Assets;
 }
 
-inline const TMap<FName, TSoftObjectPtr<UArticyObject>> UArticyPackage::GetAssetsDict()
+inline const TMap<FName, TSoftObjectPtr<UArticyObject>>& UArticyPackage::GetAssetsDict() const
 {
 	return AssetsByTechnicalName;
 }
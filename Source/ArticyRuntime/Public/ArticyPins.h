@@ -27,6 +27,14 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Articy")
 	FString Text = "";
 
+	/** The index of the script fragment in the dispatch table of the generated expresso scripts, set on import. */
+	UPROPERTY()
+	int32 ScriptIndex = INDEX_NONE;
+
+	/** GetTypeHash of Text, set on import so it is not hashed on every evaluation. */
+	UPROPERTY()
+	int32 ScriptHash = 0;
+
 	/** The Id of the object owning this pin. */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Articy")
 	FArticyId Owner;
@@ -40,6 +48,12 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Articy")
 	UArticyObject* GetOwner();
 
+	/** Pins without a script are always valid (input pins) and do nothing (output pins), without calling the expresso scripts. */
+	bool HasScript() const { return !Text.IsEmpty(); }
+
+	/** Returns the hash used to look up the script in the expresso scripts. */
+	int32 GetScriptHash() const;
+
 	//---------------------------------------------------------------------------//
 
 	EArticyPausableType GetType() override { return EArticyPausableType::Pin; }
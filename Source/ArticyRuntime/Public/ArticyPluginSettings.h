@@ -41,6 +41,22 @@ public:
 	UPROPERTY(EditAnywhere, Config, Category = ImportSettings, meta = (DisplayName = "Use legacy importer (prev. Articy 3.2.3)"))
 	bool bUseLegacyImporter;
 	
+	/**
+	 * Splits the generated expresso script fragments into this many source files, which compile in parallel
+	 * and are only rewritten if their fragments change. 0 keeps all fragments in the expresso scripts header.
+	 * Hit "Import Changes" anytime you change this setting.
+	 */
+	UPROPERTY(EditAnywhere, config, Category = ImportSettings, meta = (DisplayName = "Expresso scripts shard count", ClampMin = 0))
+	int32 ExpressoScriptsShardCount;
+
+	/**
+	 * Generates global variables which keep their values in one contiguous array per type,
+	 * instead of creating one object per variable. Variable objects are only created on demand, e.g. for Blueprints.
+	 * Requires a full reimport, as the global variables are only regenerated if they change.
+	 */
+	UPROPERTY(EditAnywhere, config, Category = ImportSettings, meta = (DisplayName = "Use flat global variable storage"))
+	bool bUseFlatGlobalVariableStorage;
+
 	/** The directory where ArticyContent will be generated and assets are looked for (when using ArticyAsset)
 	 *	Also used to search for the .articyue file to regenerate the import asset.
 	 *. Automatically set to the location of the import asset during import.
@@ -57,6 +73,25 @@ public:
 	UPROPERTY(EditAnywhere, config, Category=RuntimeSettings, meta=(DisplayName="Keep global variables between worlds"))
 	bool bKeepGlobalVariablesBetweenWorlds;
 
+	/**
+	 * If true, loaded packages reference the imported object assets directly instead of duplicating them.
+	 * A private copy of an object is only created once it is written to (or cloned).
+	 */
+	UPROPERTY(EditAnywhere, config, Category=RuntimeSettings, meta=(DisplayName="Copy objects on first write"))
+	bool bUseCopyOnWriteObjects;
+
+	/**
+	 * If true, the flow player's speculative branch evaluation does not duplicate the objects it touches.
+	 * Instead, the old values of all properties written by scripts (or SetProp) are logged and restored afterwards.
+	 * Property writes which bypass SetProp are not undone in this mode!
+	 */
+	UPROPERTY(EditAnywhere, config, Category=RuntimeSettings, meta=(DisplayName="Use undo log for shadow states"))
+	bool bUseUndoLogForShadowStates;
+
+	/** Maximum time in milliseconds the database spends per frame preparing the objects of packages loaded with LoadPackageAsync. */
+	UPROPERTY(EditAnywhere, config, Category=RuntimeSettings, meta=(DisplayName="Async package load budget (ms)", ClampMin = 0.1))
+	float AsyncLoadBudgetMs;
+
 	/** If true, converts Unity formatting in the exported articy:draft project into Unreal's rich text format. Hit "Import Changes" anytime you change this setting. */
 	UPROPERTY(EditAnywhere, config, Category=RuntimeSettings, meta=(DisplayName="Convert Unity formatting to Unreal Rich Text"))
 	bool bConvertUnityToUnrealRichText;
@@ -9,6 +9,8 @@
 
 #include "ArticyPrimitive.generated.h"
 
+class UArticyCloneableObject;
+
 /**
  * A more lightweight base class for objects imported from articy.
  */
@@ -23,6 +25,16 @@ public:
 	
 	void SetCloneID(uint32 cCloneId) { CloneId = cCloneId; }
 
+	/** Returns true if this is a package asset which was shared by a copy-on-write database. */
+	bool IsSharedAsset() const { return bSharedAsset; }
+	/**
+	 * Returns the private copy of this object if it is a package asset shared by a copy-on-write database.
+	 * Returns nullptr if it is no longer loaded by any database, as the package asset must stay untouched.
+	 */
+	IArticyReflectable* PrepareForWrite() override;
+	/** Returns the private copy of this object once the database sharing it has created one. */
+	const IArticyReflectable* GetReadTarget() const override;
+
 protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Articy")
 	FArticyId Id;
@@ -30,6 +42,7 @@ protected:
 	// TODO k2 - changed to UArticyCloneableObject
 	// friend struct FArticyClonableObject;
 	friend struct FArticyObjectShadow;
+	friend class UArticyCloneableObject;
 	/** The ID of this instance (0 is the original object). */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Articy")
 	int32 CloneId = 0;
@@ -52,4 +65,12 @@ protected:
 	
 private:
 	mutable FString Path = "";
+
+	/**
+	 * The database container that currently shares this asset and copies it on the first write.
+	 * It keeps redirecting to the copy afterwards, until the object is unloaded.
+	 */
+	TWeakObjectPtr<UArticyCloneableObject> CopyOnWriteOwner;
+	/** Set once this package asset is shared. Not a property, so copies of the asset do not inherit it. */
+	bool bSharedAsset = false;
 };
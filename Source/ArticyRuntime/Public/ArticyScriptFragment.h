@@ -19,13 +19,22 @@ class ARTICYRUNTIME_API UArticyScriptFragment : public UArticyPrimitive
 	GENERATED_BODY()
 public:
 	const FString& GetExpression() const { return Expression; }
+
+	//returns a cached hash of the expression
+	int GetExpressionHash() const;
+
+	/** The index of the fragment in the dispatch table of the generated expresso scripts. */
+	int32 GetFragmentIndex() const { return FragmentIndex; }
+	void SetFragmentIndex(int32 Index) { FragmentIndex = Index; }
+
 protected:
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Articy")
 	FString Expression = "";
 
-	//returns a cached hash of the expression
-	int GetExpressionHash() const;
+	/** Set on import, see GetFragmentIndex. */
+	UPROPERTY()
+	int32 FragmentIndex = INDEX_NONE;
 
 	template<typename Type, typename PropType>
 		friend struct ArticyObjectTypeInfo;
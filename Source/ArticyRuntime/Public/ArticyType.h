@@ -6,6 +6,8 @@
 
 #include "ArticyType.generated.h"
 
+class UArticyTypeSystem;
+
 USTRUCT(BlueprintType)
 struct ARTICYRUNTIME_API FArticyEnumValueInfo
 {
@@ -53,18 +55,27 @@ struct ARTICYRUNTIME_API FArticyType
 	GENERATED_BODY()
 
 public:
-	FArticyEnumValueInfo GetEnumValue(int Value) const;
-	FArticyEnumValueInfo GetEnumValue(const FString& ValueName) const;
+	/** The lookups return an empty info if there is no match. */
+	const FArticyEnumValueInfo& GetEnumValue(int Value) const;
+	const FArticyEnumValueInfo& GetEnumValue(const FString& ValueName) const;
 	FString GetFeatureDisplayName(UObject* Outer, const FString& FeatureName) const;
 	FString GetFeatureDisplayNameLocaKey(const FString& FeatureName) const;
-	TArray<FArticyPropertyInfo> GetProperties() const;
-	TArray<FArticyPropertyInfo> GetPropertiesInFeature(const FString& FeatureName) const;
-	FArticyPropertyInfo GetProperty(const FString& PropertyName) const;
+	const TArray<FArticyPropertyInfo>& GetProperties() const;
+	/** Returns the properties of the feature with the given display or technical name. */
+	const TArray<FArticyPropertyInfo>& GetPropertiesInFeature(const FString& FeatureName) const;
+	const FArticyPropertyInfo& GetProperty(const FString& PropertyName) const;
 	static FString LocalizeString(UObject* Outer, const FString& Input);
 	FString GetDisplayName(UObject* WorldContext);
 
 	void MergeChild(const FArticyType& Child);
 	void MergeParent(const FArticyType& Parent);
+
+	/**
+	 * Builds the hashed indices of the lookups, which fall back to linear searches until then.
+	 * The feature types are looked up in InTypeSystem by name, so copies of this type stay valid.
+	 * Called by UArticyTypeSystem once its types are loaded.
+	 */
+	void BuildIndices(const UArticyTypeSystem* InTypeSystem);
 	
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Articy")
 	FString CPPType;
@@ -89,4 +100,12 @@ public:
 	
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Articy")
 	FString TechnicalName;
+
+private:
+	bool bHasIndices = false;
+	/** Keyed by (case-insensitive) FName, so the names are not stored again per type. The lookups check for an exact match. */
+	TMap<FName, int32> PropertyIndices;
+	TMap<int32, int32> EnumValueIndices;
+	TMap<FName, int32> EnumNameIndices;
+	TWeakObjectPtr<const UArticyTypeSystem> TypeSystem;
 };
@@ -14,7 +14,42 @@ class ARTICYRUNTIME_API UArticyTypeSystem : public UObject
 	GENERATED_BODY()
 
 public:
+	/**
+	 * Returns the type system asset, which is loaded and kept alive on first use on the game thread.
+	 * Returns nullptr if called on another thread before it was loaded.
+	 */
 	static UArticyTypeSystem* Get();
-	FArticyType GetArticyType(const FString& TypeName) const;
+	/** Returns the type with the given original type name, or an empty type. */
+	const FArticyType& GetArticyType(const FString& TypeName) const;
+
+	/**
+	 * Returns the type of objects of the given class, or of its closest base class with a type.
+	 * The type is stored once here and shared by all objects of the class.
+	 */
+	const FArticyType& GetArticyTypeOfClass(const UClass* Class) const;
+
+	/** The types of the imported object definitions, by original type name. */
+	UPROPERTY()
 	TMap<FString, FArticyType> Types;
+
+	/** The types of the template features, by technical name. */
+	UPROPERTY()
+	TMap<FString, FArticyType> FeatureTypes;
+
+	/** Returns the feature type with the given technical or display name, or nullptr. */
+	const FArticyType* FindFeatureType(const FString& FeatureName) const;
+
+	/** Builds the lookup indices of all types, must be called after changing Types or FeatureTypes. */
+	void BuildIndices();
+
+	virtual void PostLoad() override;
+
+private:
+	/** The technical names of the FeatureTypes by their display names, shared by all types. */
+	TMap<FString, FString> FeatureTechnicalNames;
+
+	/** Caches GetArticyTypeOfClass, the types are found by their CPPType. */
+	mutable TMap<const UClass*, const FArticyType*> TypesByClass;
+	/** Guards TypesByClass, which is filled by lookups from any thread. */
+	mutable FRWLock TypesByClassLock;
 };
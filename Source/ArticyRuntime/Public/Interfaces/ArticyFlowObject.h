@@ -22,7 +22,10 @@ class IArticyFlowObject
 public:
 	virtual EArticyPausableType GetType() = 0;
 
-	/** Gather all branches that start at this node. */
+	/**
+	 * Gather all branches that start at this node.
+	 * The branches are appended to OutBranches, which may already contain branches of other nodes.
+	 */
 	virtual void Explore(UArticyFlowPlayer* Player, TArray<FArticyBranch>& OutBranches, const uint32& Depth) = 0;
 
 	/** Executes any script fragments found on this node. */
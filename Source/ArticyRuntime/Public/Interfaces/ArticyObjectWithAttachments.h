@@ -58,7 +58,8 @@ public:
 	UFUNCTION(BlueprintCallable, Category="ArticyObjectWithAttachments")
 	virtual TArray<FArticyId>& SetAttachmentIds(UPARAM(ref) const TArray<FArticyId>& IDs)
 	{
-		return GetAttachmentIds() = IDs;
+		static const auto PropName = FName("Attachments");
+		return SetWritableProperty<TArray<FArticyId>>(PropName, IDs);
 	}
 
 	/**
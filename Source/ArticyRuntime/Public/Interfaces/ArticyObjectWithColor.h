@@ -36,6 +36,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category="ArticyObjectWithColor")
 	virtual FLinearColor& SetColor(UPARAM(ref) const FLinearColor& Color)
 	{
-		return GetColor() = Color;
+		static const auto PropName = FName("Color");
+		return SetWritableProperty<FLinearColor>(PropName, Color);
 	}
 };
@@ -39,6 +39,6 @@ public:
 	virtual FText& SetDisplayName(UPARAM(ref) const FText& DisplayName)
 	{
 		static const auto PropName = FName("DisplayName");
-		return GetProperty<FText>(PropName) = DisplayName;
+		return SetWritableProperty<FText>(PropName, DisplayName);
 	}
 };
@@ -36,6 +36,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category="ArticyObjectWithExternalId")
 	virtual FString& SetExternalId(UPARAM(ref) const FString& ExternalId)
 	{
-		return GetExternalId() = ExternalId;
+		static const auto PropName = FName("ExternalId");
+		return SetWritableProperty<FString>(PropName, ExternalId);
 	}
 };
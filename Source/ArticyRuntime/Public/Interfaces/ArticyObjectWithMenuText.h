@@ -40,6 +40,6 @@ public:
 	virtual FText& SetMenuText(UPARAM(ref) const FText& MenuText)
 	{
 		static const auto PropName = FName("MenuText");
-		return GetProperty<FText>(PropName) = MenuText;
+		return SetWritableProperty<FText>(PropName, MenuText);
 	}
 };
@@ -36,6 +36,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category="ArticyObjectWithPosition")
 	virtual FVector2D& SetPosition(UPARAM(ref) const FVector2D& Position)
 	{
-		return GetPosition() = Position;
+		static const auto PropName = FName("Position");
+		return SetWritableProperty<FVector2D>(PropName, Position);
 	}
 };
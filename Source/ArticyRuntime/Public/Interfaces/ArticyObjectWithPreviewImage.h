@@ -37,6 +37,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category="ArticyObjectWithPreviewImage")
 	virtual UArticyPreviewImage*& SetPreviewImage(UArticyPreviewImage* PreviewImage)
 	{
-		return GetPreviewImage() = PreviewImage;
+		static const auto PropName = FName("PreviewImage");
+		return SetWritableProperty<UArticyPreviewImage*>(PropName, PreviewImage);
 	}
 };
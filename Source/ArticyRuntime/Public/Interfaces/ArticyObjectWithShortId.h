@@ -36,6 +36,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category="ArticyObjectWithShortId")
 	virtual int32& SetShortId(UPARAM(ref) const int32& ShortId)
 	{
-		return GetShortId() = ShortId;
+		static const auto PropName = FName("ShortId");
+		return SetWritableProperty<int32>(PropName, ShortId);
 	}
 };
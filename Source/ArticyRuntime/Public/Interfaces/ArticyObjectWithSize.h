@@ -37,6 +37,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category="ArticyObjectWithSize")
 	virtual FArticySize& SetSize(UPARAM(ref) const FArticySize& Size)
 	{
-		return GetSize() = Size;
+		static const auto PropName = FName("Size");
+		return SetWritableProperty<FArticySize>(PropName, Size);
 	}
 };
@@ -53,6 +53,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category="ObjectWithSpeaker")
 	virtual FArticyId& SetSpeakerId(UPARAM(ref) const FArticyId& Id)
 	{
-		return GetSpeakerId() = Id;
+		static const auto PropName = FName("Speaker");
+		return SetWritableProperty<FArticyId>(PropName, Id);
 	}
 };
@@ -36,6 +36,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category="ArticyObjectWithStageDirections")
 	virtual FText& SetStageDirections(UPARAM(ref) const FText& StageDirections)
 	{
-		return GetStageDirections() = StageDirections;
+		static const auto PropName = FName("StageDirections");
+		return SetWritableProperty<FText>(PropName, StageDirections);
 	}
 };
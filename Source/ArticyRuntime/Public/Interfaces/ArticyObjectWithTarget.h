@@ -52,6 +52,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category="ArticyObjectWithTarget")
 	virtual FArticyId& SetTargetId(UPARAM(ref) const FArticyId& Id)
 	{
-		return GetTargetId() = Id;
+		static const auto PropName = FName("Target");
+		return SetWritableProperty<FArticyId>(PropName, Id);
 	}
 };
@@ -43,7 +43,7 @@ public:
 	virtual FText& SetText(UPARAM(ref) const FText& Text)
 	{
 		static const auto PropName = FName("Text");
-		return GetProperty<FText>(PropName) = Text;
+		return SetWritableProperty<FText>(PropName, Text);
 	}
 
 	UFUNCTION(BlueprintCallable, Category = "ArticyObjectWithText")
@@ -36,6 +36,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category="ArticyObjectWithTransform")
 	virtual UArticyTransformation*& SetTransform(UArticyTransformation* Transform)
 	{
-		return GetTransform() = Transform;
+		static const auto PropName = FName("Transform");
+		return SetWritableProperty<UArticyTransformation*>(PropName, Transform);
 	}
 };
@@ -36,6 +36,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category="ArticyObjectWithVertices")
 	virtual TArray<FVector2D>& SetVertices(UPARAM(ref) const TArray<FVector2D>& Vertices)
 	{
-		return GetVertices() = Vertices;
+		static const auto PropName = FName("Vertices");
+		return SetWritableProperty<TArray<FVector2D>>(PropName, Vertices);
 	}
 };
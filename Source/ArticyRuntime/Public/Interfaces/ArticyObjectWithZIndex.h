@@ -36,6 +36,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category="ArticyObjectWithZIndex")
 	virtual float& SetZIndex(UPARAM(ref) const float& ZIndex)
 	{
-		return GetZIndex() = ZIndex;
+		static const auto PropName = FName("ZIndex");
+		return SetWritableProperty<float>(PropName, ZIndex);
 	}
 };
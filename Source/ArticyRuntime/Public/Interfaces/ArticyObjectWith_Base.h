@@ -46,6 +46,28 @@ protected:
 		return Empty;
 	}
 
+	/**
+	 * Like GetPropPtr, but on the instance writes have to go to (see PrepareForWrite).
+	 * Returns nullptr if the object must not be written to.
+	 */
+	template<typename PropType>
+	PropType* GetWritableProperty(const FName& PropName)
+	{
+		IArticyReflectable* Target = PrepareForWrite();
+		return Target ? Target->GetPropPtr<PropType>(PropName) : nullptr;
+	}
+
+	/** Writes Value to the property, if the object can be written to, and returns the property. */
+	template<typename PropType>
+	PropType& SetWritableProperty(const FName& PropName, const PropType& Value)
+	{
+		if(PropType* prop = GetWritableProperty<PropType>(PropName))
+			return *prop = Value;
+
+		//the write was rejected, the unchanged value is returned
+		return GetProperty<PropType>(PropName);
+	}
+
 	FText GetStringText(UObject* Outer, const FName& PropName, const FText* BackupText = nullptr)
 	{
 		FText& Key = GetProperty<FText>(PropName);
@@ -8,10 +8,30 @@
 #include "Runtime/CoreUObject/Public/UObject/Interface.h"
 #include "Runtime/Launch/Resources/Version.h"
 #include "ArticyChangedProperty.h"
+#include "ShadowStateManager.h"
 #include "ArticyReflectable.generated.h"
 
 DECLARE_MULTICAST_DELEGATE_OneParam(FReportChangedDelegate, FArticyChangedProperty&);
 
+/**
+ * The properties of a class by name.
+ * Tables are built once per class and never change afterwards, so they can be read from any thread.
+ */
+struct ARTICYRUNTIME_API FArticyPropertyTable
+{
+	FProperty* Find(FName Property) const
+	{
+		FProperty* const* prop = Properties.Find(Property);
+		return prop ? *prop : nullptr;
+	}
+
+	/** Returns the table of Class, building it on first use. */
+	static const FArticyPropertyTable& Get(const UClass* Class);
+
+private:
+	TMap<FName, FProperty*> Properties;
+};
+
 UINTERFACE()
 class UArticyReflectable : public UInterface { GENERATED_BODY() };
 
@@ -45,11 +65,11 @@ public:
 	template<typename TValue>
 	TValue* GetPropPtr(FName Property, int32 ArrayIndex = 0) const
 	{
-		//look up the (hopefully already cached) property pointers
-		auto propPointers = GetPropertyPointers();
-		auto prop = propPointers.Find(Property);
+		//shared objects which were already copied are read from the copy
+		const IArticyReflectable* Target = GetReadTarget();
+		FProperty* prop = Target->GetProperty(Property);
 		if(prop)
-			return (*prop)->ContainerPtrToValuePtr<TValue>(_getUObject(), ArrayIndex);
+			return prop->ContainerPtrToValuePtr<TValue>(Target->_getUObject(), ArrayIndex);
 
 		return nullptr;
 	}
@@ -57,49 +77,31 @@ public:
 	/** Returns the pointer to a property of a given name. */
 	FProperty* GetProperty(FName Property) const
 	{
-		//look up the (hopefully already cached) property pointers
-		auto propPointers = GetPropertyPointers();
-		auto prop = propPointers.Find(Property);
-		if(prop)
-			return *prop;
-
-		return nullptr;
+		return FArticyPropertyTable::Get(GetObjectClass()).Find(Property);
 	}
 
 	/** Returns true if the Property can be found on the given Class. */
 	static bool HasProperty(const UClass* Class, const FName &Property)
 	{
-		return GetPropertyPointers(Class).Find(Property) != nullptr;
+		return FArticyPropertyTable::Get(Class).Find(Property) != nullptr;
 	}
 
 	virtual UClass* GetObjectClass() const { return _getUObject()->GetClass(); }
 
-	FReportChangedDelegate ReportChanged;
-
-private:
 	/**
-	 * Caches and returns all UProperty pointers of this UClass.
-	 * They are cached because they can only be found by iterating over
-	 * them, using the TFieldIterator.
+	 * Returns the instance that property writes have to go to.
+	 * Objects that are shared with other users (copy-on-write) return a private copy here,
+	 * or nullptr if they must not be written to anymore.
 	 */
-	TMap<FName, FProperty*>& GetPropertyPointers() const
-	{
-		return GetPropertyPointers(GetObjectClass());
-	}
+	virtual IArticyReflectable* PrepareForWrite() { return this; }
 
-	static TMap<FName, FProperty*>& GetPropertyPointers(const UClass* Class)
-	{
-		static TMap<const UClass*, TMap<FName, FProperty*>> PropertyPointers;
-		auto& pp = PropertyPointers.FindOrAdd(Class);
-		if(pp.Num() == 0)
-		{
-			//cache property pointers
-			for(TFieldIterator<FProperty> It(Class); It; ++It)
-				pp.Add(*It->GetNameCPP(), *It);
-		}
+	/**
+	 * Returns the instance that property reads have to go to.
+	 * Shared objects (copy-on-write) return their private copy here once it was created.
+	 */
+	virtual const IArticyReflectable* GetReadTarget() const { return this; }
 
-		return pp;
-	}
+	FReportChangedDelegate ReportChanged;
 };
 
 //---------------------------------------------------------------------------//
@@ -107,9 +109,18 @@ private:
 template <typename TValue>
 TValue IArticyReflectable::SetProp(FName Property, TValue Value, int32 ArrayIndex)
 {
-	TValue* valPtr = GetPropPtr<TValue>(Property, ArrayIndex);
-	if(valPtr)
+	//shared objects are copied before the first write
+	IArticyReflectable* Target = PrepareForWrite();
+	if(!Target)
+		return Value;
+	if(Target != this)
+		return Target->SetProp<TValue>(Property, Value, ArrayIndex);
+
+	FProperty* prop = GetProperty(Property);
+	if(prop)
 	{
+		TValue* valPtr = prop->ContainerPtrToValuePtr<TValue>(_getUObject(), ArrayIndex);
+
 		FArticyChangedProperty ChangedProperty;
 		ChangedProperty.Property = Property;
 		auto ObjectReference = Cast<UArticyBaseObject>(this);
@@ -118,6 +129,8 @@ TValue IArticyReflectable::SetProp(FName Property, TValue Value, int32 ArrayInde
 			ChangedProperty.ObjectReference = ObjectReference;
 		}
 
+		//speculative writes are rolled back once the shadow state is popped
+		IShadowStateManager::RecordPropertyChange(_getUObject(), prop);
 		(*valPtr) = Value;
 
 		ReportChanged.Broadcast(ChangedProperty);
@@ -33,16 +33,88 @@ public:
 	FDelegateHandle RegisterOnPopState(LambdaType Lambda);
 	void UnregisterOnPopState(FDelegateHandle Delegate);
 
+	/**
+	 * Adds an entry to the undo log of the current shadow level.
+	 * When the state is popped, Undo is called with Target, in reverse order of registration
+	 * and before the OnPopState delegates are notified.
+	 * This is much cheaper than RegisterOnPopState if many objects are touched per shadow level.
+	 */
+	ARTICYRUNTIME_API void AddToUndoLog(void* Target, void (*Undo)(void* Target));
+	/**
+	 * Same as AddToUndoLog, for an entry of Object identified by Index (e.g. a map key) instead of a pointer,
+	 * as the entry might be moved before the state is popped. Undo is skipped if Object was destroyed.
+	 */
+	ARTICYRUNTIME_API void AddToUndoLog(UObject* Object, int32 Index, void (*Undo)(UObject* Object, int32 Index));
+
+	/**
+	 * If true, objects are not duplicated per shadow level. Instead, the old values of
+	 * all properties written during a shadow state are logged and restored on PopState.
+	 */
+	virtual bool UsesPropertyUndoLog() const { return false; }
+
+	/**
+	 * Logs the current value of Property on Object, if the shadow state manager owning Object
+	 * (its nearest outer implementing this interface) is in a shadow state and uses the property undo log.
+	 * Has to be called right before the property is written.
+	 */
+	ARTICYRUNTIME_API static void RecordPropertyChange(UObject* Object, FProperty* Property);
+
 	uint32 GetShadowLevel() const { return ShadowLevel; }
 
+	/** Counts the property writes recorded with RecordPropertyChange outside of shadow states. */
+	uint64 GetPropertyChangeCount() const { return PropertyChangeCount; }
+
 private:
 
+	uint64 PropertyChangeCount = 0;
+
 	/** The current shadow level of this GV instance. */
 	uint32 ShadowLevel = 0;
 
 	/** A stack of OnPopState delegates. The last one is the one for the current shadow level. */
 	TArray<FOnPopState> OnPopStateDelegates;
 
+	struct FUndoEntry
+	{
+		void* Target = nullptr;
+		void (*Undo)(void* Target) = nullptr;
+
+		/** Used instead of Target and Undo by entries of objects. */
+		TWeakObjectPtr<UObject> Object;
+		int32 Index = 0;
+		void (*UndoObject)(UObject* Object, int32 Index) = nullptr;
+	};
+
+	/**
+	 * The undo log entries of all shadow levels, in order of registration.
+	 * UndoLogStarts holds the index of the first entry of each shadow level.
+	 */
+	TArray<FUndoEntry> UndoLog;
+
+	struct FPropertyUndoEntry
+	{
+		TWeakObjectPtr<UObject> Object;
+		FProperty* Property;
+		/** The offset of the old value in PropertyUndoValues. */
+		int32 ValueOffset;
+	};
+
+	/** The logged property values of all shadow levels, in order of registration. */
+	TArray<FPropertyUndoEntry> PropertyUndoLog;
+	TArray<uint8, TAlignedHeapAllocator<16>> PropertyUndoValues;
+
+	struct FUndoLogStart
+	{
+		int32 UndoLog;
+		int32 PropertyUndoLog;
+		int32 PropertyUndoValues;
+	};
+
+	/** Where the undo logs of each shadow level start. */
+	TArray<FUndoLogStart> UndoLogStarts;
+
+	void AddPropertyToUndoLog(UObject* Object, FProperty* Property);
+
 	friend class UArticyFlowPlayer;
 
 	void PushState(uint32 NewShadowLevel);